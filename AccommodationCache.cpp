@@ -0,0 +1,183 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#include "AccommodationCache.hpp"
+#include <atomic>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+    const std::size_t SHARD_COUNT = 16;
+
+    struct Key {
+        unsigned long long state;
+        unsigned mask;
+
+        bool operator==(const Key& rhs) const {
+            return state == rhs.state && mask == rhs.mask;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            return std::hash<unsigned long long>()(key.state) * 64 + key.mask;
+        }
+    };
+
+    /**
+     * One lock's worth of entries. The list is in recency order, most recent
+     * first, and the map points into it.
+     */
+    struct Shard {
+        std::mutex mutex;
+        std::list<std::pair<Key, AccommodationCache::Result>> entries;
+        std::unordered_map<Key, std::list<std::pair<Key, AccommodationCache::Result>>::iterator, KeyHash> index;
+    };
+
+    Shard cache_shards[SHARD_COUNT];
+    std::atomic<std::size_t> shard_capacity((1 << 16) / SHARD_COUNT);
+
+    /**
+     * State ids are handed out in runs with a stride, so they are mixed
+     * (Fibonacci hashing) before the top bits pick a shard.
+     */
+    Shard& shardOf(const Key& key) {
+        return cache_shards[(((key.state ^ key.mask) * 0x9E3779B97F4A7C15ull) >> 32) % SHARD_COUNT];
+    }
+
+    /**
+     * Classifies the entry found under a dish's state id.
+     */
+    AccommodationCache::Lookup classify(const AccommodationCache::Result& entry) {
+        return entry.fixed_point && entry.output_state == entry.input_state ? AccommodationCache::ALREADY_APPLIED
+                                                                            : AccommodationCache::CACHED_RESULT;
+    }
+
+    /**
+     * Stores an entry, evicting the shard's least recently used one if it is full.
+     */
+    void store(const Key& key, AccommodationCache::Result result) {
+        Shard& shard = shardOf(key);
+        const std::size_t capacity = shard_capacity;
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto entry = shard.index.find(key);
+        if (entry != shard.index.end()) {
+            entry->second->second = std::move(result);
+            shard.entries.splice(shard.entries.begin(), shard.entries, entry->second);
+            return;
+        }
+        while (!shard.entries.empty() && shard.entries.size() >= capacity) {
+            shard.index.erase(shard.entries.back().first);
+            shard.entries.pop_back();
+        }
+        if (capacity == 0) {
+            return;
+        }
+        shard.entries.emplace_front(key, std::move(result));
+        shard.index.emplace(key, shard.entries.begin());
+    }
+}
+
+/**
+ * @brief Looks up a memoized accommodation and marks it as recently used.
+ *
+ * @param dish The dish about to be accommodated.
+ * @param request The accommodation to apply.
+ * @param result Receives the cached result on CACHED_RESULT.
+ * @return Lookup MISS, ALREADY_APPLIED or CACHED_RESULT.
+ */
+AccommodationCache::Lookup AccommodationCache::find(const Dish* dish, const Dish::DietaryRequest& request, Result& result) {
+    Key key = {dish->getStateId(), requestMask(request)};
+    Shard& shard = shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto entry = shard.index.find(key);
+    if (entry == shard.index.end()) {
+        return MISS;
+    }
+    Lookup lookup = classify(entry->second->second);
+    shard.entries.splice(shard.entries.begin(), shard.entries, entry->second);
+    if (lookup == CACHED_RESULT) {
+        result = entry->second->second;
+    }
+    return lookup;
+}
+
+/**
+ * @param dish The dish about to be accommodated.
+ * @param request The accommodation to apply.
+ * @return bool True if the dish already is the unchanged, stable result of the request.
+ */
+bool AccommodationCache::isApplied(const Dish* dish, const Dish::DietaryRequest& request) {
+    Key key = {dish->getStateId(), requestMask(request)};
+    Shard& shard = shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto entry = shard.index.find(key);
+    return entry != shard.index.end() && classify(entry->second->second) == ALREADY_APPLIED;
+}
+
+/**
+ * @brief Memoizes an accommodation under the dish's state id before it.
+ *
+ * If the result is a fixed point, its own state id is also recorded, without
+ * the ingredients, so that accommodating it again is known to change nothing.
+ *
+ * @param request The accommodation applied.
+ * @param result The outcome.
+ */
+void AccommodationCache::insert(const Dish::DietaryRequest& request, Result result) {
+    const unsigned mask = requestMask(request);
+    if (result.fixed_point && result.output_state != result.input_state) {
+        store({result.output_state, mask}, {result.output_state, result.output_state, true, {}, result.level, result.flag});
+    }
+    store({result.input_state, mask}, std::move(result));
+}
+
+/**
+ * @brief Removes all entries.
+ */
+void AccommodationCache::clear() {
+    for (Shard& shard : cache_shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.index.clear();
+        shard.entries.clear();
+    }
+}
+
+/**
+ * @return std::size_t The number of cached results.
+ */
+std::size_t AccommodationCache::size() {
+    std::size_t total = 0;
+    for (Shard& shard : cache_shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        total += shard.entries.size();
+    }
+    return total;
+}
+
+/**
+ * @brief Sets the total capacity, shared evenly by the shards.
+ *
+ * Shards above their new share shrink on their next insert.
+ *
+ * @param capacity The number of entries kept.
+ */
+void AccommodationCache::setCapacity(const std::size_t& capacity) {
+    shard_capacity = (capacity + SHARD_COUNT - 1) / SHARD_COUNT;
+}
+
+/**
+ * @brief Packs a DietaryRequest into a bitmask.
+ *
+ * @param request A dietary request.
+ * @return unsigned One bit per flag, in declaration order.
+ */
+unsigned AccommodationCache::requestMask(const Dish::DietaryRequest& request) {
+    return (request.vegetarian ? 1u : 0u) | (request.vegan ? 2u : 0u) |
+           (request.gluten_free ? 4u : 0u) | (request.nut_free ? 8u : 0u) |
+           (request.low_sodium ? 16u : 0u) | (request.low_sugar ? 32u : 0u);
+}
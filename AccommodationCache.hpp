@@ -0,0 +1,93 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#ifndef ACCOMMODATION_CACHE_HPP
+#define ACCOMMODATION_CACHE_HPP
+
+#include "Dish.hpp"
+#include <cstddef>
+
+/**
+ * @class AccommodationCache
+ * @brief Memoizes the result of Dish::dietaryAccommodations().
+ *
+ * Entries are keyed by the dish's state id (see Dish::getStateId()) and the
+ * request's bitmask. Every mutator gives a dish a fresh state id, while a
+ * copy keeps its original's, so the id names the dish's contents: the copy a
+ * DietaryView materializes finds the entries made for its base dish, and vice
+ * versa. Each entry holds the state id after the accommodation and the
+ * accommodated ingredient list and flags, not a copy of the dish. A state id
+ * is never reused, so entries never go stale; those for dishes that have
+ * since changed simply age out.
+ *
+ * The cache is shared by all dishes and is safe to use from several threads.
+ * It is split into shards with their own lock, and each shard evicts its
+ * least recently used entry when it is full.
+ */
+class AccommodationCache {
+public:
+    /**
+     * What find() found.
+     */
+    enum Lookup {
+        MISS,               ///< The accommodation has to be computed.
+        ALREADY_APPLIED,    ///< The dish is the unchanged result and accommodating it again changes nothing.
+        CACHED_RESULT       ///< The dish is unchanged since before the accommodation; the result was copied out.
+    };
+
+    /**
+     * The outcome of one accommodation.
+     */
+    struct Result {
+        unsigned long long input_state;   ///< State id of the dish before the accommodation.
+        unsigned long long output_state;  ///< State id of the dish after it.
+        bool fixed_point;                 ///< True if accommodating the result again would change nothing.
+        Dish::IngredientList ingredients; ///< The accommodated ingredients.
+        int level;                        ///< The accommodated spiciness or sweetness level; unused for main courses.
+        bool flag;                        ///< The accommodated vegetarian, gluten-free or contains-nuts flag.
+    };
+
+    /**
+     * @param dish The dish about to be accommodated.
+     * @param request The accommodation to apply.
+     * @param result Receives the cached result when CACHED_RESULT is returned.
+     * @return How the accommodation can be answered.
+     */
+    static Lookup find(const Dish* dish, const Dish::DietaryRequest& request, Result& result);
+
+    /**
+     * @return True if find() would return ALREADY_APPLIED. Nothing is copied.
+     */
+    static bool isApplied(const Dish* dish, const Dish::DietaryRequest& request);
+
+    /**
+     * Records the result of an accommodation under result.input_state.
+     * @param request The accommodation applied.
+     * @param result The outcome.
+     */
+    static void insert(const Dish::DietaryRequest& request, Result result);
+
+    /**
+     * Removes all entries.
+     */
+    static void clear();
+
+    /**
+     * @return The number of cached results.
+     */
+    static std::size_t size();
+
+    /**
+     * @param capacity The number of entries kept; the least recently used ones are evicted beyond it.
+     */
+    static void setCapacity(const std::size_t& capacity);
+
+    /**
+     * @param request A dietary request.
+     * @return The request's flags packed into one bit each.
+     */
+    static unsigned requestMask(const Dish::DietaryRequest& request);
+};
+
+#endif // ACCOMMODATION_CACHE_HPP
@@ -3,6 +3,7 @@
  * @author [Farhana Sultana]
  */
 #include "Appetizer.hpp"
+#include "AccommodationCache.hpp"
 #include <iomanip>
 
 /**
@@ -10,7 +11,7 @@
  * Initializes all private members with default values.
  */
 Appetizer::Appetizer()
-    : Dish(), serving_style_(PLATED), spiciness_level_(0), vegetarian_(false) {}
+    : Dish(APPETIZER), serving_style_(PLATED), spiciness_level_(0), vegetarian_(false) {}
 
 /**
  * Parameterized constructor.
@@ -24,7 +25,7 @@ Appetizer::Appetizer()
  * @param vegetarian Flag indicating if the appetizer is vegetarian.
  */
 Appetizer::Appetizer(const std::string& name, const std::vector<std::string>& ingredients, const int &prep_time, const double &price, const CuisineType &cuisine_type, const ServingStyle &serving_style, const int &spiciness_level, const bool &vegetarian)
-    : Dish(name, ingredients, prep_time, price, cuisine_type), serving_style_(serving_style), spiciness_level_(spiciness_level), vegetarian_(vegetarian) {}
+    : Dish(APPETIZER, name, ingredients, prep_time, price, cuisine_type), serving_style_(serving_style), spiciness_level_(spiciness_level), vegetarian_(vegetarian) {}
 
 /**
  * Sets the serving style of the appetizer.
@@ -33,6 +34,7 @@ Appetizer::Appetizer(const std::string& name, const std::vector<std::string>& in
  */
 void Appetizer::setServingStyle(const ServingStyle &serving_style) {
     serving_style_ = serving_style;
+    renewStateId();
 }
 
 /**
@@ -49,6 +51,7 @@ Appetizer::ServingStyle Appetizer::getServingStyle() const {
  */
 void Appetizer::setSpicinessLevel(const int &spiciness_level) {
     spiciness_level_ = spiciness_level;
+    renewStateId();
 }
 
 /**
@@ -65,6 +68,7 @@ int Appetizer::getSpicinessLevel() const {
  */
 void Appetizer::setVegetarian(const bool &vegetarian) {
     vegetarian_ = vegetarian;
+    renewStateId();
 }
 
 /**
@@ -74,6 +78,13 @@ bool Appetizer::isVegetarian() const {
     return vegetarian_;
 }
 
+/**
+ * @return A new copy of this appetizer, owned by the caller.
+ */
+Appetizer* Appetizer::clone() const {
+    return new Appetizer(*this);
+}
+
 /**
 * Displays the appetizer's details.
 * @post Outputs the appetizer's details, including name, ingredients,
@@ -138,9 +149,28 @@ without substitution.
 `ingredients_`.
 * Gluten-containing ingredients are: "Wheat", "Flour",
 "Bread", "Pasta", "Barley", "Rye", "Oats", "Crust".
+* Results are memoized in AccommodationCache by the dish and the request.
+Repeating the request on the unchanged result returns at once when it
+would change nothing, and the ingredients are only re-filtered after the
+dish has been changed since.
 */
 
 void Appetizer::dietaryAccommodations(const DietaryRequest& request) {
+    AccommodationCache::Result cached;
+    switch (AccommodationCache::find(this, request, cached)) {
+        case AccommodationCache::ALREADY_APPLIED:
+            return;
+        case AccommodationCache::CACHED_RESULT:
+            setIngredients(cached.ingredients);
+            vegetarian_ = cached.flag;
+            spiciness_level_ = cached.level;
+            restoreStateId(cached.output_state);
+            return;
+        case AccommodationCache::MISS:
+            break;
+    }
+    const unsigned long long input_state = getStateId();
+
     if (request.vegetarian) {
         vegetarian_ = true;
         std::vector<std::string> non_vegetarian = {"Meat", "Chicken", "Fish", "Beef", "Pork", "Lamb", "Shrimp", "Bacon"};
@@ -192,4 +222,7 @@ void Appetizer::dietaryAccommodations(const DietaryRequest& request) {
         }
         setIngredients(new_ingredients);
     }
-}A
+
+    renewStateId();
+    AccommodationCache::insert(request, {input_state, getStateId(), !request.low_sodium || spiciness_level_ == 0, getIngredientList(), spiciness_level_, vegetarian_});
+}
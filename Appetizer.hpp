@@ -54,6 +54,11 @@ public:
      * @param request The dietary request containing the dietary requirements.
      */
     void dietaryAccommodations(const DietaryRequest& request) override;
+
+    /**
+     * @return A new copy of this appetizer, owned by the caller.
+     */
+    Appetizer* clone() const override;
     
     /**
      * Sets the serving style of the appetizer.
@@ -0,0 +1,240 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#ifndef ARRAY_BAG_HPP
+#define ARRAY_BAG_HPP
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+/**
+ * @class ArrayBag
+ * @brief An unordered collection stored in a contiguous array that grows as needed.
+ *
+ * The array doubles in size whenever it is full, so add() only fails if
+ * memory runs out. reserve() pre-sizes the array when the final size is known.
+ */
+template <class ItemType>
+class ArrayBag {
+public:
+    /**
+     * Default constructor.
+     * @post The bag is empty. No storage is allocated until the first add() or reserve().
+     */
+    ArrayBag();
+
+    ArrayBag(const ArrayBag& other);
+    ArrayBag(ArrayBag&& other) noexcept;
+    ArrayBag& operator=(ArrayBag other) noexcept;
+    virtual ~ArrayBag();
+
+    /**
+     * @return The number of items in the bag.
+     */
+    int getCurrentSize() const;
+
+    /**
+     * @return The number of items the bag can hold before it has to grow.
+     */
+    int getCapacity() const;
+
+    /**
+     * @return True if the bag is empty, false otherwise.
+     */
+    bool isEmpty() const;
+
+    /**
+     * Adds an item to the bag, growing the array geometrically if it is full.
+     * @param new_entry The item to add.
+     * @return True if the item was added.
+     */
+    bool add(const ItemType& new_entry);
+
+    /**
+     * Removes one occurrence of an item. The last item is moved into its slot.
+     * @param an_entry The item to remove.
+     * @return True if an occurrence was found and removed.
+     */
+    bool remove(const ItemType& an_entry);
+
+    /**
+     * Removes all items. The allocated capacity is kept.
+     */
+    void clear();
+
+    /**
+     * @param an_entry The item to look for.
+     * @return True if the bag contains the item.
+     */
+    bool contains(const ItemType& an_entry) const;
+
+    /**
+     * @param an_entry The item to count.
+     * @return The number of times the item occurs in the bag.
+     */
+    int getFrequencyOf(const ItemType& an_entry) const;
+
+    /**
+     * @return A vector holding the items in bag order.
+     */
+    std::vector<ItemType> toVector() const;
+
+    /**
+     * Ensures the bag can hold at least new_capacity items without growing.
+     * @param new_capacity The number of items to make room for.
+     * @post getCapacity() >= new_capacity.
+     */
+    void reserve(const int& new_capacity);
+
+    /**
+     * Releases unused capacity.
+     * @post getCapacity() == getCurrentSize().
+     */
+    void shrink_to_fit();
+
+protected:
+    static const int DEFAULT_CAPACITY = 100; ///< Capacity of the first allocation.
+    ItemType* items_;  ///< Array of bag items.
+    int item_count_;   ///< Current count of bag items.
+    int capacity_;     ///< Length of the items_ array.
+
+    /**
+     * @param target The item to look for.
+     * @return The index of the first occurrence of target, or -1 if it is absent.
+     */
+    int getIndexOf(const ItemType& target) const;
+
+private:
+    /**
+     * Moves the items into a new array of the given length.
+     * @pre new_capacity >= item_count_.
+     */
+    void resize(const int& new_capacity);
+};
+
+template <class ItemType>
+ArrayBag<ItemType>::ArrayBag() : items_(nullptr), item_count_(0), capacity_(0) {}
+
+template <class ItemType>
+ArrayBag<ItemType>::ArrayBag(const ArrayBag& other)
+    : items_(nullptr), item_count_(0), capacity_(0) {
+    reserve(other.item_count_);
+    std::copy(other.items_, other.items_ + other.item_count_, items_);
+    item_count_ = other.item_count_;
+}
+
+template <class ItemType>
+ArrayBag<ItemType>::ArrayBag(ArrayBag&& other) noexcept
+    : items_(other.items_), item_count_(other.item_count_), capacity_(other.capacity_) {
+    other.items_ = nullptr;
+    other.item_count_ = 0;
+    other.capacity_ = 0;
+}
+
+template <class ItemType>
+ArrayBag<ItemType>& ArrayBag<ItemType>::operator=(ArrayBag other) noexcept {
+    std::swap(items_, other.items_);
+    std::swap(item_count_, other.item_count_);
+    std::swap(capacity_, other.capacity_);
+    return *this;
+}
+
+template <class ItemType>
+ArrayBag<ItemType>::~ArrayBag() {
+    delete[] items_;
+}
+
+template <class ItemType>
+int ArrayBag<ItemType>::getCurrentSize() const {
+    return item_count_;
+}
+
+template <class ItemType>
+int ArrayBag<ItemType>::getCapacity() const {
+    return capacity_;
+}
+
+template <class ItemType>
+bool ArrayBag<ItemType>::isEmpty() const {
+    return item_count_ == 0;
+}
+
+template <class ItemType>
+bool ArrayBag<ItemType>::add(const ItemType& new_entry) {
+    if (item_count_ == capacity_) {
+        ItemType entry = new_entry;  // new_entry may refer into items_
+        resize(capacity_ == 0 ? DEFAULT_CAPACITY : capacity_ * 2);
+        items_[item_count_++] = std::move(entry);
+        return true;
+    }
+    items_[item_count_++] = new_entry;
+    return true;
+}
+
+template <class ItemType>
+bool ArrayBag<ItemType>::remove(const ItemType& an_entry) {
+    int found_index = getIndexOf(an_entry);
+    if (found_index < 0) {
+        return false;
+    }
+    item_count_--;
+    items_[found_index] = items_[item_count_];
+    return true;
+}
+
+template <class ItemType>
+void ArrayBag<ItemType>::clear() {
+    item_count_ = 0;
+}
+
+template <class ItemType>
+bool ArrayBag<ItemType>::contains(const ItemType& an_entry) const {
+    return getIndexOf(an_entry) > -1;
+}
+
+template <class ItemType>
+int ArrayBag<ItemType>::getFrequencyOf(const ItemType& an_entry) const {
+    return static_cast<int>(std::count(items_, items_ + item_count_, an_entry));
+}
+
+template <class ItemType>
+std::vector<ItemType> ArrayBag<ItemType>::toVector() const {
+    return std::vector<ItemType>(items_, items_ + item_count_);
+}
+
+template <class ItemType>
+void ArrayBag<ItemType>::reserve(const int& new_capacity) {
+    if (new_capacity > capacity_) {
+        resize(new_capacity);
+    }
+}
+
+template <class ItemType>
+void ArrayBag<ItemType>::shrink_to_fit() {
+    if (capacity_ > item_count_) {
+        resize(item_count_);
+    }
+}
+
+template <class ItemType>
+int ArrayBag<ItemType>::getIndexOf(const ItemType& target) const {
+    for (int i = 0; i < item_count_; i++) {
+        if (items_[i] == target) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+template <class ItemType>
+void ArrayBag<ItemType>::resize(const int& new_capacity) {
+    ItemType* resized = new_capacity > 0 ? new ItemType[new_capacity] : nullptr;
+    std::move(items_, items_ + item_count_, resized);
+    delete[] items_;
+    items_ = resized;
+    capacity_ = new_capacity;
+}
+
+#endif // ARRAY_BAG_HPP
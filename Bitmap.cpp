@@ -0,0 +1,298 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#include "Bitmap.hpp"
+#include <algorithm>
+#include <bitset>
+#include <iterator>
+
+namespace {
+    int popcount(std::uint64_t word) {
+        return static_cast<int>(std::bitset<64>(word).count());
+    }
+
+    /**
+     * @pre word != 0.
+     * @return The position of the lowest set bit.
+     */
+    int lowestBit(std::uint64_t word) {
+        return popcount((word & (~word + 1)) - 1);
+    }
+}
+
+Bitmap::Bitmap() {}
+
+/**
+ * @brief Builds the bitmap of every id below count, using full dense blocks.
+ *
+ * @param count The number of ids.
+ * @return Bitmap The ids 0 to count - 1.
+ */
+Bitmap Bitmap::firstN(const int& count) {
+    Bitmap bitmap;
+    for (int first = 0; first < count; first += 65536) {
+        int size = std::min(count - first, 65536);
+        std::vector<std::uint64_t> words(WORDS, 0);
+        std::fill(words.begin(), words.begin() + size / 64, ~std::uint64_t(0));
+        if (size % 64 != 0) {
+            words[size / 64] = (std::uint64_t(1) << (size % 64)) - 1;
+        }
+        assignWords(bitmap.blocks_[static_cast<std::uint16_t>(first >> 16)], std::move(words));
+    }
+    return bitmap;
+}
+
+/**
+ * @brief Adds an id. A sparse block that outgrows ARRAY_LIMIT is converted to a bitset.
+ *
+ * @param id A non-negative id.
+ */
+void Bitmap::set(const int& id) {
+    Block& block = blocks_[static_cast<std::uint16_t>(id >> 16)];
+    std::uint16_t low = static_cast<std::uint16_t>(id & 0xFFFF);
+    if (block.isDense()) {
+        std::uint64_t bit = std::uint64_t(1) << (low % 64);
+        if (!(block.words[low / 64] & bit)) {
+            block.words[low / 64] |= bit;
+            block.cardinality++;
+        }
+        return;
+    }
+    auto pos = std::lower_bound(block.values.begin(), block.values.end(), low);
+    if (pos != block.values.end() && *pos == low) {
+        return;
+    }
+    block.values.insert(pos, low);
+    block.cardinality++;
+    if (block.cardinality > ARRAY_LIMIT) {
+        assignWords(block, denseWords(block));
+    }
+}
+
+/**
+ * @brief Removes an id. A bitset that shrinks to half of ARRAY_LIMIT is converted back to an array.
+ *
+ * @param id A non-negative id.
+ */
+void Bitmap::reset(const int& id) {
+    auto entry = blocks_.find(static_cast<std::uint16_t>(id >> 16));
+    if (entry == blocks_.end()) {
+        return;
+    }
+    Block& block = entry->second;
+    std::uint16_t low = static_cast<std::uint16_t>(id & 0xFFFF);
+    if (block.isDense()) {
+        std::uint64_t bit = std::uint64_t(1) << (low % 64);
+        if (block.words[low / 64] & bit) {
+            block.words[low / 64] &= ~bit;
+            if (--block.cardinality <= ARRAY_LIMIT / 2) {  // Hysteresis, so a block at the limit does not flip on every update.
+                assignWords(block, std::move(block.words));
+            }
+        }
+    } else {
+        auto pos = std::lower_bound(block.values.begin(), block.values.end(), low);
+        if (pos != block.values.end() && *pos == low) {
+            block.values.erase(pos);
+            block.cardinality--;
+        }
+    }
+    if (block.cardinality == 0) {
+        blocks_.erase(entry);
+    }
+}
+
+bool Bitmap::test(const int& id) const {
+    auto entry = blocks_.find(static_cast<std::uint16_t>(id >> 16));
+    if (entry == blocks_.end()) {
+        return false;
+    }
+    const Block& block = entry->second;
+    std::uint16_t low = static_cast<std::uint16_t>(id & 0xFFFF);
+    if (block.isDense()) {
+        return (block.words[low / 64] >> (low % 64)) & 1;
+    }
+    return std::binary_search(block.values.begin(), block.values.end(), low);
+}
+
+long long Bitmap::count() const {
+    long long total = 0;
+    for (const auto& entry : blocks_) {
+        total += entry.second.cardinality;
+    }
+    return total;
+}
+
+bool Bitmap::empty() const {
+    return blocks_.empty();
+}
+
+/**
+ * @return std::vector<int> Every id, ascending.
+ */
+std::vector<int> Bitmap::toVector() const {
+    std::vector<int> ids;
+    ids.reserve(count());
+    for (const auto& entry : blocks_) {
+        int base = int(entry.first) << 16;
+        const Block& block = entry.second;
+        if (block.isDense()) {
+            for (int w = 0; w < WORDS; w++) {
+                for (std::uint64_t word = block.words[w]; word != 0; word &= word - 1) {
+                    ids.push_back(base + w * 64 + lowestBit(word));
+                }
+            }
+        } else {
+            for (std::uint16_t low : block.values) {
+                ids.push_back(base + low);
+            }
+        }
+    }
+    return ids;
+}
+
+/**
+ * @brief Keeps only the ids also in other. Two arrays are intersected by a
+ * merge; otherwise the blocks are intersected word by word.
+ */
+Bitmap& Bitmap::operator&=(const Bitmap& other) {
+    for (auto entry = blocks_.begin(); entry != blocks_.end();) {
+        auto match = other.blocks_.find(entry->first);
+        Block& block = entry->second;
+        if (match == other.blocks_.end()) {
+            entry = blocks_.erase(entry);
+            continue;
+        }
+        const Block& theirs = match->second;
+        if (!block.isDense() && !theirs.isDense()) {
+            std::vector<std::uint16_t> common;
+            std::set_intersection(block.values.begin(), block.values.end(),
+                                  theirs.values.begin(), theirs.values.end(), std::back_inserter(common));
+            block.values.swap(common);
+            block.cardinality = static_cast<int>(block.values.size());
+        } else if (!block.isDense()) {
+            auto last = std::remove_if(block.values.begin(), block.values.end(), [&theirs](std::uint16_t low) {
+                return !((theirs.words[low / 64] >> (low % 64)) & 1);
+            });
+            block.values.erase(last, block.values.end());
+            block.cardinality = static_cast<int>(block.values.size());
+        } else {
+            std::vector<std::uint64_t> words = denseWords(theirs);
+            for (int w = 0; w < WORDS; w++) words[w] &= block.words[w];
+            assignWords(block, std::move(words));
+        }
+        entry = block.cardinality == 0 ? blocks_.erase(entry) : std::next(entry);
+    }
+    return *this;
+}
+
+/**
+ * @brief Adds every id in other. Small array unions are merged; anything
+ * that could exceed ARRAY_LIMIT is combined as bitsets.
+ */
+Bitmap& Bitmap::operator|=(const Bitmap& other) {
+    for (const auto& match : other.blocks_) {
+        auto entry = blocks_.find(match.first);
+        if (entry == blocks_.end()) {
+            blocks_.emplace(match.first, match.second);
+            continue;
+        }
+        Block& block = entry->second;
+        const Block& theirs = match.second;
+        if (!block.isDense() && !theirs.isDense() && block.cardinality + theirs.cardinality <= ARRAY_LIMIT) {
+            std::vector<std::uint16_t> merged;
+            std::set_union(block.values.begin(), block.values.end(),
+                           theirs.values.begin(), theirs.values.end(), std::back_inserter(merged));
+            block.values.swap(merged);
+            block.cardinality = static_cast<int>(block.values.size());
+        } else {
+            std::vector<std::uint64_t> words = denseWords(block);
+            if (theirs.isDense()) {
+                for (int w = 0; w < WORDS; w++) words[w] |= theirs.words[w];
+            } else {
+                for (std::uint16_t low : theirs.values) words[low / 64] |= std::uint64_t(1) << (low % 64);
+            }
+            assignWords(block, std::move(words));
+        }
+    }
+    return *this;
+}
+
+/**
+ * @brief Removes every id in other.
+ */
+Bitmap& Bitmap::operator-=(const Bitmap& other) {
+    for (auto entry = blocks_.begin(); entry != blocks_.end();) {
+        auto match = other.blocks_.find(entry->first);
+        Block& block = entry->second;
+        if (match == other.blocks_.end()) {
+            ++entry;
+            continue;
+        }
+        const Block& theirs = match->second;
+        if (!block.isDense()) {
+            auto last = std::remove_if(block.values.begin(), block.values.end(), [&theirs](std::uint16_t low) {
+                if (theirs.isDense()) return bool((theirs.words[low / 64] >> (low % 64)) & 1);
+                return std::binary_search(theirs.values.begin(), theirs.values.end(), low);
+            });
+            block.values.erase(last, block.values.end());
+            block.cardinality = static_cast<int>(block.values.size());
+        } else {
+            std::vector<std::uint64_t> words = std::move(block.words);
+            if (theirs.isDense()) {
+                for (int w = 0; w < WORDS; w++) words[w] &= ~theirs.words[w];
+            } else {
+                for (std::uint16_t low : theirs.values) words[low / 64] &= ~(std::uint64_t(1) << (low % 64));
+            }
+            assignWords(block, std::move(words));
+        }
+        entry = block.cardinality == 0 ? blocks_.erase(entry) : std::next(entry);
+    }
+    return *this;
+}
+
+bool Bitmap::operator==(const Bitmap& other) const {
+    return toVector() == other.toVector();
+}
+
+/**
+ * @param block A sparse or dense block.
+ * @return std::vector<std::uint64_t> The block as a bitset of WORDS words.
+ */
+std::vector<std::uint64_t> Bitmap::denseWords(const Block& block) {
+    if (block.isDense()) {
+        return block.words;
+    }
+    std::vector<std::uint64_t> words(WORDS, 0);
+    for (std::uint16_t low : block.values) {
+        words[low / 64] |= std::uint64_t(1) << (low % 64);
+    }
+    return words;
+}
+
+/**
+ * @brief Stores a bitset as an array if it holds at most ARRAY_LIMIT ids, otherwise as is.
+ *
+ * @param block The block to overwrite.
+ * @param words A bitset of WORDS words.
+ */
+void Bitmap::assignWords(Block& block, std::vector<std::uint64_t> words) {
+    int cardinality = 0;
+    for (std::uint64_t word : words) {
+        cardinality += popcount(word);
+    }
+    block.cardinality = cardinality;
+    block.values.clear();
+    if (cardinality > ARRAY_LIMIT) {
+        block.words = std::move(words);
+        return;
+    }
+    block.words.clear();
+    block.words.shrink_to_fit();
+    block.values.reserve(cardinality);
+    for (int w = 0; w < WORDS; w++) {
+        for (std::uint64_t word = words[w]; word != 0; word &= word - 1) {
+            block.values.push_back(static_cast<std::uint16_t>(w * 64 + lowestBit(word)));
+        }
+    }
+}
@@ -0,0 +1,91 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#ifndef BITMAP_HPP
+#define BITMAP_HPP
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+/**
+ * @class Bitmap
+ * @brief A compressed set of non-negative integer ids, in the style of Roaring bitmaps.
+ *
+ * Ids are split into blocks of 65536 by their high bits. Each non-empty
+ * block is stored either as a sorted array of 16-bit offsets, while it
+ * holds at most ARRAY_LIMIT ids, or as a 65536-bit bitset once it is
+ * denser. Sparse sets therefore cost two bytes per id and dense sets one
+ * bit per id, and the set operations work block by block with merges or
+ * word-wide logic.
+ */
+class Bitmap {
+public:
+    static const int ARRAY_LIMIT = 4096; ///< Largest block stored as an array.
+
+    /**
+     * Default constructor.
+     * @post The bitmap is empty.
+     */
+    Bitmap();
+
+    /**
+     * @param count The number of ids.
+     * @return A bitmap holding every id in [0, count).
+     */
+    static Bitmap firstN(const int& count);
+
+    void set(const int& id);
+    void reset(const int& id);
+    bool test(const int& id) const;
+
+    /**
+     * @return The number of ids in the bitmap.
+     */
+    long long count() const;
+
+    bool empty() const;
+
+    /**
+     * @return The ids in ascending order.
+     */
+    std::vector<int> toVector() const;
+
+    Bitmap& operator&=(const Bitmap& other);  ///< Intersection.
+    Bitmap& operator|=(const Bitmap& other);  ///< Union.
+    Bitmap& operator-=(const Bitmap& other);  ///< Difference: ids in this bitmap but not in other.
+
+    friend Bitmap operator&(Bitmap a, const Bitmap& b) { return a &= b; }
+    friend Bitmap operator|(Bitmap a, const Bitmap& b) { return a |= b; }
+    friend Bitmap operator-(Bitmap a, const Bitmap& b) { return a -= b; }
+
+    bool operator==(const Bitmap& other) const;
+
+private:
+    static const int WORDS = 1024; ///< 64-bit words in a dense block.
+
+    /**
+     * One block of 65536 ids. Exactly one of values and words is in use.
+     */
+    struct Block {
+        std::vector<std::uint16_t> values; ///< Sorted offsets, while the block is sparse.
+        std::vector<std::uint64_t> words;  ///< Bitset of WORDS words, once the block is dense.
+        int cardinality = 0;
+        bool isDense() const { return !words.empty(); }
+    };
+
+    std::map<std::uint16_t, Block> blocks_; ///< High 16 bits of the id -> block.
+
+    /**
+     * Helper function to return a dense copy of a block
+     */
+    static std::vector<std::uint64_t> denseWords(const Block& block);
+
+    /**
+     * Helper function to store a bitset in whichever form suits its cardinality
+     */
+    static void assignWords(Block& block, std::vector<std::uint64_t> words);
+};
+
+#endif // BITMAP_HPP
@@ -0,0 +1,109 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#ifndef BOUNDED_CHANNEL_HPP
+#define BOUNDED_CHANNEL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+/**
+ * @class BoundedChannel
+ * @brief A fixed-capacity FIFO queue for passing items between threads.
+ *
+ * push() blocks while the channel is full, which applies backpressure to the
+ * producer, and pop() blocks while it is empty. Once close() is called no
+ * more items are accepted, and pop() returns false after the remaining items
+ * have been drained.
+ */
+template <class ItemType>
+class BoundedChannel {
+public:
+    /**
+     * @param capacity The maximum number of queued items (at least 1).
+     */
+    explicit BoundedChannel(const std::size_t& capacity)
+        : capacity_(capacity > 0 ? capacity : 1), closed_(false) {}
+
+    BoundedChannel(const BoundedChannel&) = delete;
+    BoundedChannel& operator=(const BoundedChannel&) = delete;
+
+    /**
+     * Adds an item, waiting for room if the channel is full.
+     * @param item The item to add.
+     * @return False if the channel was closed and the item was not added.
+     */
+    bool push(ItemType item) {
+        return push(std::move(item), [] {});
+    }
+
+    /**
+     * Adds an item like push(ItemType) and, while the channel is still locked,
+     * calls on_added(). Whatever on_added() records is therefore visible to any
+     * thread that has since closed or popped from the channel.
+     * @param item The item to add.
+     * @param on_added Called once if the item was added; must not use the channel.
+     * @return False if the channel was closed and the item was not added.
+     */
+    template <class Callback>
+    bool push(ItemType item, Callback on_added) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this] { return closed_ || items_.size() < capacity_; });
+        if (closed_) {
+            return false;
+        }
+        items_.push_back(std::move(item));
+        on_added();
+        not_empty_.notify_one();
+        return true;
+    }
+
+    /**
+     * Removes the oldest item, waiting for one if the channel is empty.
+     * @param item Receives the removed item.
+     * @return False if the channel is closed and empty.
+     */
+    bool pop(ItemType& item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+        if (items_.empty()) {
+            return false;
+        }
+        item = std::move(items_.front());
+        items_.pop_front();
+        not_full_.notify_one();
+        return true;
+    }
+
+    /**
+     * Stops accepting items and wakes every waiting thread.
+     */
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        not_full_.notify_all();
+        not_empty_.notify_all();
+    }
+
+    /**
+     * @return The number of queued items.
+     */
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return items_.size();
+    }
+
+private:
+    const std::size_t capacity_;
+    bool closed_;
+    std::deque<ItemType> items_;
+    mutable std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+};
+
+#endif // BOUNDED_CHANNEL_HPP
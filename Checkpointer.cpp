@@ -0,0 +1,191 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#include "Checkpointer.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+namespace {
+    /**
+     * Reads a whole file into a string.
+     * @return True if the file exists and was read.
+     */
+    bool readFile(const std::string& filename, std::string& contents) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            contents.clear();
+            return false;
+        }
+        contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    std::string sealedName(const std::string& log_filename) {
+        return log_filename + ".sealed";
+    }
+}
+
+/**
+ * @brief Creates a checkpointer for a live log. The background thread is not started.
+ *
+ * @param order_log The live log attached to the kitchen.
+ * @param snapshot_filename The path of the snapshot file.
+ * @param max_log_bytes Log size at which the background thread checkpoints.
+ * @param poll_interval How often the background thread checks the log size.
+ */
+Checkpointer::Checkpointer(OrderLog& order_log, const std::string& snapshot_filename,
+                           const std::size_t& max_log_bytes, const std::chrono::milliseconds& poll_interval)
+    : order_log_(order_log), snapshot_filename_(snapshot_filename), max_log_bytes_(max_log_bytes),
+      poll_interval_(poll_interval), checkpoint_count_(0), stopping_(false) {}
+
+Checkpointer::~Checkpointer() {
+    stop();
+}
+
+void Checkpointer::start() {
+    if (!worker_.joinable()) {
+        stopping_ = false;
+        worker_ = std::thread(&Checkpointer::run, this);
+    }
+}
+
+void Checkpointer::stop() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+int Checkpointer::getCheckpointCount() const {
+    std::lock_guard<std::mutex> lock(checkpoint_mutex_);
+    return checkpoint_count_;
+}
+
+/**
+ * @brief Polls the log size and checkpoints whenever it passes the limit.
+ */
+void Checkpointer::run() {
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    while (!stopping_) {
+        wake_.wait_for(lock, poll_interval_, [this] { return stopping_; });
+        if (stopping_) {
+            break;
+        }
+        if (order_log_.getLogSize() >= max_log_bytes_) {
+            lock.unlock();
+            checkpoint();
+            lock.lock();
+        }
+    }
+}
+
+/**
+ * @brief Folds the live log into a new snapshot.
+ *
+ * If a sealed segment is left over from an interrupted checkpoint it is
+ * folded in first, and the live log is rotated on the next checkpoint.
+ *
+ * @return bool True if a new snapshot replaced the old one.
+ */
+bool Checkpointer::checkpoint() {
+    std::lock_guard<std::mutex> lock(checkpoint_mutex_);
+    const std::string sealed_filename = sealedName(order_log_.getFilename());
+
+    std::string segment;
+    if (!readFile(sealed_filename, segment) && !order_log_.rotate(sealed_filename)) {
+        return false;
+    }
+
+    Kitchen merged;
+    loadBase(snapshot_filename_, sealed_filename, merged, segment);
+    if (!writeSnapshot(merged.toVector(), segment, snapshot_filename_)) {
+        return false;
+    }
+    std::remove(sealed_filename.c_str());
+    checkpoint_count_++;
+    return true;
+}
+
+/**
+ * @brief Saves a kitchen as a snapshot with no absorbed segment.
+ *
+ * @param kitchen The kitchen to save.
+ * @param snapshot_filename The path of the snapshot file.
+ * @return bool True if the snapshot was written.
+ */
+bool Checkpointer::writeSnapshot(const Kitchen& kitchen, const std::string& snapshot_filename) {
+    return writeSnapshot(kitchen.toVector(), std::string(), snapshot_filename);
+}
+
+/**
+ * @brief Writes a snapshot to a temporary file and renames it into place.
+ *
+ * @param dishes The dishes to save.
+ * @param segment The contents of the segment these dishes already include.
+ * @param snapshot_filename The path of the snapshot file.
+ * @return bool True if the snapshot was written and renamed.
+ */
+bool Checkpointer::writeSnapshot(const std::vector<Dish*>& dishes, const std::string& segment,
+                                 const std::string& snapshot_filename) {
+    const std::string temp_filename = snapshot_filename + ".tmp";
+    std::remove(temp_filename.c_str());
+    bool written;
+    {
+        OrderLog snapshot(temp_filename, OrderLog::SYNC_ON_COMMIT, 1 << 16, std::chrono::milliseconds(0));
+        snapshot.logSnapshotBase(segment);
+        for (Dish* dish : dishes) {
+            snapshot.logNewOrder(*dish);
+        }
+        written = snapshot.isOpen() && snapshot.commit();
+    }
+    if (!written) {
+        std::remove(temp_filename.c_str());
+        return false;
+    }
+#ifdef _WIN32
+    std::remove(snapshot_filename.c_str());  // rename() does not replace files on Windows.
+#endif
+    return std::rename(temp_filename.c_str(), snapshot_filename.c_str()) == 0;
+}
+
+/**
+ * @brief Loads the snapshot, then the sealed segment unless the snapshot already contains it.
+ *
+ * @param snapshot_filename The path of the snapshot file.
+ * @param sealed_filename The path of the sealed segment.
+ * @param kitchen The kitchen to load into.
+ * @param segment Receives the contents of the sealed segment.
+ * @return int The number of records applied.
+ */
+int Checkpointer::loadBase(const std::string& snapshot_filename, const std::string& sealed_filename,
+                           Kitchen& kitchen, std::string& segment) {
+    std::string snapshot;
+    readFile(snapshot_filename, snapshot);
+    readFile(sealed_filename, segment);
+    int applied = OrderLog::replay(snapshot.data(), snapshot.data() + snapshot.size(), kitchen);
+    if (!segment.empty() && !OrderLog::absorbs(snapshot, segment)) {
+        applied += OrderLog::replay(segment.data(), segment.data() + segment.size(), kitchen);
+    }
+    return applied;
+}
+
+/**
+ * @brief Rebuilds a kitchen from the snapshot and the log files behind it.
+ *
+ * @param snapshot_filename The path of the snapshot file.
+ * @param log_filename The path of the live log.
+ * @param kitchen The kitchen to load into.
+ * @return int The number of records applied.
+ */
+int Checkpointer::recover(const std::string& snapshot_filename, const std::string& log_filename, Kitchen& kitchen) {
+    std::string segment;
+    int applied = loadBase(snapshot_filename, sealedName(log_filename), kitchen, segment);
+    int tail = OrderLog::replay(log_filename, kitchen);
+    return applied + (tail > 0 ? tail : 0);
+}
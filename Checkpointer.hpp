@@ -0,0 +1,129 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#ifndef CHECKPOINTER_HPP
+#define CHECKPOINTER_HPP
+
+#include "OrderLog.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class Checkpointer
+ * @brief Keeps a kitchen's write-ahead log bounded by folding it into a snapshot.
+ *
+ * A checkpoint rotates the live log to "<log>.sealed" and then, without
+ * touching the kitchen, loads the previous snapshot, replays the sealed
+ * segment on top of it, writes the result as the new snapshot and deletes
+ * the segment. The kitchen's thread only waits for the rotation, i.e. one
+ * group commit and a rename, however large the kitchen is.
+ *
+ * A snapshot is itself an OrderLog file: a SNAPSHOT_BASE record naming the
+ * segment it absorbed, followed by one NEW_ORDER record per dish. It is
+ * written to "<snapshot>.tmp" and renamed into place, so a crash at any
+ * point leaves either the old snapshot and the segment, or the new snapshot
+ * and a segment it is known to contain. recover() handles both.
+ *
+ * On disk there is at most one snapshot, one temporary snapshot, one sealed
+ * segment and the live log, which is checkpointed once it grows past
+ * max_log_bytes.
+ */
+class Checkpointer {
+public:
+    /**
+     * @param order_log The live log attached to the kitchen.
+     * @param snapshot_filename The path of the snapshot file.
+     * @param max_log_bytes Log size at which the background thread checkpoints.
+     * @param poll_interval How often the background thread checks the log size.
+     */
+    Checkpointer(OrderLog& order_log, const std::string& snapshot_filename,
+                 const std::size_t& max_log_bytes = 1 << 24,
+                 const std::chrono::milliseconds& poll_interval = std::chrono::milliseconds(100));
+
+    /**
+     * Stops the background thread, if it is running.
+     */
+    ~Checkpointer();
+
+    Checkpointer(const Checkpointer&) = delete;
+    Checkpointer& operator=(const Checkpointer&) = delete;
+
+    /**
+     * Starts a thread that checkpoints whenever the log exceeds max_log_bytes.
+     */
+    void start();
+
+    /**
+     * Stops the background thread, waiting for a checkpoint in progress.
+     */
+    void stop();
+
+    /**
+     * Takes a checkpoint on the calling thread.
+     * @return True if the log was folded into a new snapshot.
+     */
+    bool checkpoint();
+
+    /**
+     * @return The number of checkpoints completed.
+     */
+    int getCheckpointCount() const;
+
+    /**
+     * Writes the whole kitchen as a snapshot that absorbs no segment.
+     * Use it once before attaching a log to a kitchen that already holds dishes.
+     * @param kitchen The kitchen to save.
+     * @param snapshot_filename The path of the snapshot file.
+     * @return True if the snapshot was written and renamed into place.
+     */
+    static bool writeSnapshot(const Kitchen& kitchen, const std::string& snapshot_filename);
+
+    /**
+     * Rebuilds a kitchen from a snapshot, a sealed segment the snapshot does
+     * not yet contain, and the live log, in that order. Missing files are
+     * treated as empty.
+     * @param snapshot_filename The path of the snapshot file.
+     * @param log_filename The path of the live log.
+     * @param kitchen The kitchen to load into; it should not have a log attached.
+     * @return The number of records applied.
+     */
+    static int recover(const std::string& snapshot_filename, const std::string& log_filename, Kitchen& kitchen);
+
+private:
+    OrderLog& order_log_;
+    std::string snapshot_filename_;
+    std::size_t max_log_bytes_;
+    std::chrono::milliseconds poll_interval_;
+    int checkpoint_count_;
+    bool stopping_;
+    std::thread worker_;
+    mutable std::mutex checkpoint_mutex_;   ///< Serializes checkpoints and guards the counters.
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+
+    /**
+     * Helper function to run the background loop.
+     */
+    void run();
+
+    /**
+     * Helper function to write dishes as a snapshot absorbing the given segment.
+     */
+    static bool writeSnapshot(const std::vector<Dish*>& dishes, const std::string& segment,
+                              const std::string& snapshot_filename);
+
+    /**
+     * Helper function to load the snapshot and any unabsorbed segment into a kitchen.
+     * @return The number of records applied.
+     */
+    static int loadBase(const std::string& snapshot_filename, const std::string& sealed_filename,
+                        Kitchen& kitchen, std::string& segment);
+};
+
+#endif // CHECKPOINTER_HPP
@@ -0,0 +1,249 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#include "ColumnarFile.hpp"
+#include "Kitchen.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    const char MAGIC[4] = {'K', 'C', 'O', 'L'};
+    const std::uint32_t VERSION = 1;
+
+    template <class T>
+    void put(std::ostream& out, const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <class T>
+    bool get(std::istream& in, T& value) {
+        return bool(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    void putStrings(std::ostream& out, const std::vector<std::string>& strings) {
+        put<std::uint32_t>(out, strings.size());
+        for (const auto& text : strings) {
+            put<std::uint32_t>(out, text.size());
+            out.write(text.data(), text.size());
+        }
+    }
+
+    bool getStrings(std::istream& in, std::vector<std::string>& strings) {
+        std::uint32_t count, size;
+        if (!get(in, count)) return false;
+        for (std::uint32_t i = 0; i < count; i++) {
+            if (!get(in, size)) return false;
+            std::string text(size, '\0');
+            if (!in.read(&text[0], size)) return false;
+            strings.push_back(std::move(text));
+        }
+        return true;
+    }
+
+    std::uint64_t stringsBytes(const std::vector<std::string>& strings) {
+        std::uint64_t bytes = sizeof(std::uint32_t);
+        for (const auto& text : strings) {
+            bytes += sizeof(std::uint32_t) + text.size();
+        }
+        return bytes;
+    }
+
+    template <class T>
+    void putColumn(std::ostream& out, const ColumnarTable::Column& column, const std::vector<T>& values) {
+        put<std::uint8_t>(out, column);
+        put<std::uint64_t>(out, values.size() * sizeof(T));
+        out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    }
+
+    /**
+     * Appends a fixed-width column payload to a vector.
+     */
+    template <class T>
+    bool getColumn(std::istream& in, const std::uint64_t& bytes, std::vector<T>& values) {
+        if (bytes % sizeof(T) != 0) return false;
+        std::size_t first = values.size();
+        values.resize(first + bytes / sizeof(T));
+        return bool(in.read(reinterpret_cast<char*>(values.data() + first), bytes));
+    }
+
+    /**
+     * Returns the dictionary id of a string, adding it if it is new.
+     */
+    std::uint32_t encode(const std::string& text, std::unordered_map<std::string, std::uint32_t>& ids,
+                         std::vector<std::string>& added) {
+        auto entry = ids.emplace(text, static_cast<std::uint32_t>(ids.size()));
+        if (entry.second) {
+            added.push_back(text);
+        }
+        return entry.first->second;
+    }
+}
+
+/**
+ * @brief Writes the header with the dish type and cuisine dictionaries.
+ *
+ * @param out The stream to write to.
+ * @param chunk_rows The number of dishes per chunk.
+ */
+ColumnarWriter::ColumnarWriter(std::ostream& out, const int& chunk_rows)
+    : out_(out), chunk_rows_(chunk_rows > 0 ? chunk_rows : 1), finished_(false) {
+    out_.write(MAGIC, sizeof(MAGIC));
+    put(out_, VERSION);
+    putStrings(out_, {"APPETIZER", "MAINCOURSE", "DESSERT"});
+    putStrings(out_, {"ITALIAN", "MEXICAN", "CHINESE", "INDIAN", "AMERICAN", "FRENCH", "OTHER"});
+    ingredient_offsets_.push_back(0);
+}
+
+ColumnarWriter::~ColumnarWriter() {
+    if (!finished_) {
+        finish();
+    }
+}
+
+/**
+ * @brief Encodes one dish into the current chunk.
+ *
+ * @param dish The dish to add.
+ */
+void ColumnarWriter::append(const Dish& dish) {
+    types_.push_back(dish.getKind());
+    cuisines_.push_back(Kitchen::stringToCuisineType(dish.getCuisineType()));
+    prep_times_.push_back(dish.getPrepTime());
+    prices_.push_back(dish.getPrice());
+    names_.push_back(encode(dish.getName(), name_ids_, new_names_));
+    for (const auto& ingredient : dish.getIngredientList()) {
+        ingredients_.push_back(encode(ingredient, ingredient_ids_, new_ingredients_));
+    }
+    ingredient_offsets_.push_back(static_cast<std::uint32_t>(ingredients_.size()));
+    if (static_cast<int>(types_.size()) == chunk_rows_) {
+        writeChunk();
+    }
+}
+
+/**
+ * @brief Writes the buffered rows as one chunk, dictionaries first.
+ */
+void ColumnarWriter::writeChunk() {
+    if (types_.empty()) {
+        return;
+    }
+    put<std::uint32_t>(out_, types_.size());
+    put<std::uint32_t>(out_, 8);
+
+    put<std::uint8_t>(out_, ColumnarTable::NAME_DICTIONARY);
+    put<std::uint64_t>(out_, stringsBytes(new_names_));
+    putStrings(out_, new_names_);
+    put<std::uint8_t>(out_, ColumnarTable::INGREDIENT_DICTIONARY);
+    put<std::uint64_t>(out_, stringsBytes(new_ingredients_));
+    putStrings(out_, new_ingredients_);
+
+    putColumn(out_, ColumnarTable::TYPE, types_);
+    putColumn(out_, ColumnarTable::CUISINE, cuisines_);
+    putColumn(out_, ColumnarTable::PREP_TIME, prep_times_);
+    putColumn(out_, ColumnarTable::PRICE, prices_);
+    putColumn(out_, ColumnarTable::NAME, names_);
+
+    put<std::uint8_t>(out_, ColumnarTable::INGREDIENTS);
+    put<std::uint64_t>(out_, (ingredient_offsets_.size() + ingredients_.size()) * sizeof(std::uint32_t));
+    out_.write(reinterpret_cast<const char*>(ingredient_offsets_.data()), ingredient_offsets_.size() * sizeof(std::uint32_t));
+    out_.write(reinterpret_cast<const char*>(ingredients_.data()), ingredients_.size() * sizeof(std::uint32_t));
+
+    new_names_.clear();
+    new_ingredients_.clear();
+    types_.clear();
+    cuisines_.clear();
+    prep_times_.clear();
+    prices_.clear();
+    names_.clear();
+    ingredients_.clear();
+    ingredient_offsets_.assign(1, 0);
+}
+
+/**
+ * @brief Flushes the last chunk and writes the end marker.
+ *
+ * @return bool True if every write succeeded.
+ */
+bool ColumnarWriter::finish() {
+    writeChunk();
+    put<std::uint32_t>(out_, 0);
+    finished_ = true;
+    return bool(out_.flush());
+}
+
+/**
+ * @brief Reads the selected columns of every chunk, skipping the others with seekg.
+ *
+ * @param in A stream positioned at the file header.
+ * @param columns The columns to load.
+ * @param table Receives the columns.
+ * @return bool True if the file was read to its end marker.
+ */
+bool ColumnarReader::read(std::istream& in, const unsigned& columns, ColumnarTable& table) {
+    table = ColumnarTable();
+    unsigned wanted = columns;
+    if (wanted & ColumnarTable::NAME) wanted |= ColumnarTable::NAME_DICTIONARY;
+    if (wanted & ColumnarTable::INGREDIENTS) wanted |= ColumnarTable::INGREDIENT_DICTIONARY;
+
+    char magic[sizeof(MAGIC)];
+    std::uint32_t version;
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), MAGIC) ||
+        !get(in, version) || version != VERSION ||
+        !getStrings(in, table.type_names) || !getStrings(in, table.cuisine_names)) {
+        return false;
+    }
+    if (wanted & ColumnarTable::INGREDIENTS) {
+        table.ingredient_offsets.push_back(0);
+    }
+
+    while (true) {
+        std::uint32_t rows = 0, column_count = 0;
+        if (!get(in, rows)) return false;  // truncated before the end marker
+        if (rows == 0) return true;
+        if (!get(in, column_count)) return false;
+        for (std::uint32_t c = 0; c < column_count; c++) {
+            std::uint8_t column;
+            std::uint64_t bytes;
+            if (!get(in, column) || !get(in, bytes)) return false;
+            if (!(wanted & column)) {
+                if (!in.seekg(bytes, std::ios::cur)) return false;
+                continue;
+            }
+            bool ok = true;
+            switch (column) {
+                case ColumnarTable::TYPE: ok = bytes == rows * sizeof(std::uint8_t) && getColumn(in, bytes, table.types); break;
+                case ColumnarTable::CUISINE: ok = bytes == rows * sizeof(std::uint8_t) && getColumn(in, bytes, table.cuisines); break;
+                case ColumnarTable::PREP_TIME: ok = bytes == rows * sizeof(std::int32_t) && getColumn(in, bytes, table.prep_times); break;
+                case ColumnarTable::PRICE: ok = bytes == rows * sizeof(double) && getColumn(in, bytes, table.prices); break;
+                case ColumnarTable::NAME: ok = bytes == rows * sizeof(std::uint32_t) && getColumn(in, bytes, table.name_ids); break;
+                case ColumnarTable::NAME_DICTIONARY: ok = getStrings(in, table.names); break;
+                case ColumnarTable::INGREDIENT_DICTIONARY: ok = getStrings(in, table.ingredients); break;
+                case ColumnarTable::INGREDIENTS: {
+                    std::vector<std::uint32_t> chunk;
+                    ok = getColumn(in, bytes, chunk) && chunk.size() > rows && chunk[rows] == chunk.size() - rows - 1;
+                    if (!ok) break;
+                    std::uint64_t base = table.ingredient_offsets.back();
+                    for (std::uint32_t r = 1; r <= rows; r++) {
+                        table.ingredient_offsets.push_back(base + chunk[r]);
+                    }
+                    table.ingredient_ids.insert(table.ingredient_ids.end(), chunk.begin() + rows + 1, chunk.end());
+                    break;
+                }
+                default: ok = bool(in.seekg(bytes, std::ios::cur)); break;
+            }
+            if (!ok) return false;
+        }
+        table.row_count += rows;
+    }
+}
+
+bool ColumnarReader::read(const std::string& filename, const unsigned& columns, ColumnarTable& table) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error opening file: " << filename << std::endl;
+        return false;
+    }
+    return read(file, columns, table);
+}
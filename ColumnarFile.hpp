@@ -0,0 +1,156 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#ifndef COLUMNAR_FILE_HPP
+#define COLUMNAR_FILE_HPP
+
+#include "Dish.hpp"
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Columnar kitchen file layout. All integers are in host byte order and
+ * every string is a u32 byte length followed by the bytes.
+ *
+ *   header:  "KCOL"  u32 version (1)
+ *            u32 count, then that many strings: the dish type names, indexed by Dish::DishKind
+ *            u32 count, then that many strings: the cuisine names, indexed by Dish::CuisineType
+ *   chunks:  u32 row count (0 ends the file)
+ *            u32 column count, then per column: u8 column id, u64 payload bytes, payload
+ *
+ * Column payloads, for a chunk of n rows:
+ *   TYPE                   n x u8 Dish::DishKind
+ *   CUISINE                n x u8 Dish::CuisineType
+ *   PREP_TIME              n x i32
+ *   PRICE                  n x f64
+ *   NAME                   n x u32 id into the name dictionary
+ *   INGREDIENTS            (n + 1) x u32 offsets, then offsets[n] x u32 ids into the
+ *                          ingredient dictionary; row i uses ids [offsets[i], offsets[i + 1])
+ *   NAME_DICTIONARY        u32 count, then that many strings
+ *   INGREDIENT_DICTIONARY  u32 count, then that many strings
+ *
+ * Dictionaries are written incrementally: each chunk's dictionary column
+ * holds only the strings first used in that chunk, which receive the next
+ * ids in order. Dictionary columns precede the columns that refer to them.
+ * Because every payload is length-prefixed, a reader skips the columns it
+ * was not asked for without reading them.
+ */
+
+/**
+ * @struct ColumnarTable
+ * @brief The columns read from a columnar kitchen file. Unselected columns stay empty.
+ */
+struct ColumnarTable {
+    /**
+     * Column ids as stored in the file; also bits for selecting columns to read.
+     */
+    enum Column : std::uint8_t {
+        TYPE = 1,
+        NAME = 2,
+        CUISINE = 4,
+        PREP_TIME = 8,
+        PRICE = 16,
+        INGREDIENTS = 32,
+        NAME_DICTIONARY = 64,
+        INGREDIENT_DICTIONARY = 128
+    };
+
+    static const unsigned ALL_COLUMNS = TYPE | NAME | CUISINE | PREP_TIME | PRICE | INGREDIENTS;
+
+    long long row_count = 0;
+    std::vector<std::string> type_names;        ///< Indexed by Dish::DishKind.
+    std::vector<std::string> cuisine_names;     ///< Indexed by Dish::CuisineType.
+    std::vector<std::uint8_t> types;
+    std::vector<std::uint8_t> cuisines;
+    std::vector<std::int32_t> prep_times;
+    std::vector<double> prices;
+    std::vector<std::uint32_t> name_ids;        ///< Indexes into names.
+    std::vector<std::string> names;
+    std::vector<std::uint64_t> ingredient_offsets; ///< Row i's ingredients are ingredient_ids[offsets[i], offsets[i + 1]).
+    std::vector<std::uint32_t> ingredient_ids;     ///< Indexes into ingredients.
+    std::vector<std::string> ingredients;
+};
+
+/**
+ * @class ColumnarWriter
+ * @brief Streams dishes into the columnar layout, one chunk of rows at a time.
+ *
+ * Only the current chunk and the two dictionaries are held in memory.
+ */
+class ColumnarWriter {
+public:
+    /**
+     * Writes the file header.
+     * @param out The stream to write to.
+     * @param chunk_rows The number of dishes per chunk.
+     */
+    ColumnarWriter(std::ostream& out, const int& chunk_rows = 65536);
+
+    /**
+     * Calls finish() if it has not been called.
+     */
+    ~ColumnarWriter();
+
+    ColumnarWriter(const ColumnarWriter&) = delete;
+    ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+
+    /**
+     * Adds one dish, writing a chunk when it is full.
+     */
+    void append(const Dish& dish);
+
+    /**
+     * Writes the last partial chunk and the end marker.
+     * @return True if every write succeeded.
+     */
+    bool finish();
+
+private:
+    std::ostream& out_;
+    int chunk_rows_;
+    bool finished_;
+    std::unordered_map<std::string, std::uint32_t> name_ids_;
+    std::unordered_map<std::string, std::uint32_t> ingredient_ids_;
+    std::vector<std::string> new_names_;        ///< Name dictionary entries added in this chunk.
+    std::vector<std::string> new_ingredients_;  ///< Ingredient dictionary entries added in this chunk.
+    std::vector<std::uint8_t> types_;
+    std::vector<std::uint8_t> cuisines_;
+    std::vector<std::int32_t> prep_times_;
+    std::vector<double> prices_;
+    std::vector<std::uint32_t> names_;
+    std::vector<std::uint32_t> ingredient_offsets_;
+    std::vector<std::uint32_t> ingredients_;
+
+    /**
+     * Helper function to write the buffered rows as one chunk and clear them
+     */
+    void writeChunk();
+};
+
+/**
+ * @class ColumnarReader
+ * @brief Loads selected columns of a columnar kitchen file.
+ */
+class ColumnarReader {
+public:
+    /**
+     * @param in A stream positioned at the file header.
+     * @param columns The columns to load, as an OR of ColumnarTable::Column bits.
+     *                The dictionaries of NAME and INGREDIENTS are loaded with them.
+     * @param table Receives the columns; unselected columns are left empty.
+     * @return True if the file was read to its end marker.
+     */
+    static bool read(std::istream& in, const unsigned& columns, ColumnarTable& table);
+
+    /**
+     * @param filename The path of the columnar file.
+     */
+    static bool read(const std::string& filename, const unsigned& columns, ColumnarTable& table);
+};
+
+#endif // COLUMNAR_FILE_HPP
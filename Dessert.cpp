@@ -3,6 +3,7 @@
  * @author [Farhana Sultana]
  */
 #include "Dessert.hpp"
+#include "AccommodationCache.hpp"
 #include <iomanip>
 
 /**
@@ -10,7 +11,7 @@
  * Initializes all private members with default values.
  */
 Dessert::Dessert()
-    : Dish(), flavor_profile_(SWEET), sweetness_level_(0), contains_nuts_(false) {}
+    : Dish(DESSERT), flavor_profile_(SWEET), sweetness_level_(0), contains_nuts_(false) {}
 
 /**
  * Parameterized constructor.
@@ -24,7 +25,7 @@ Dessert::Dessert()
  * @param contains_nuts Flag indicating if the dessert contains nuts.
  */
 Dessert::Dessert(const std::string& name, const std::vector<std::string>& ingredients, const int &prep_time, const double &price, const CuisineType &cuisine_type, const FlavorProfile &flavor_profile, const int &sweetness_level, const bool &contains_nuts)
-    : Dish(name, ingredients, prep_time, price, cuisine_type), flavor_profile_(flavor_profile), sweetness_level_(sweetness_level), contains_nuts_(contains_nuts) {}
+    : Dish(DESSERT, name, ingredients, prep_time, price, cuisine_type), flavor_profile_(flavor_profile), sweetness_level_(sweetness_level), contains_nuts_(contains_nuts) {}
 
 /**
  * Sets the flavor profile of the dessert.
@@ -33,6 +34,7 @@ Dessert::Dessert(const std::string& name, const std::vector<std::string>& ingred
  */
 void Dessert::setFlavorProfile(const FlavorProfile &flavor_profile) {
     flavor_profile_ = flavor_profile;
+    renewStateId();
 }
 
 /**
@@ -49,6 +51,7 @@ Dessert::FlavorProfile Dessert::getFlavorProfile() const {
  */
 void Dessert::setSweetnessLevel(const int &sweetness_level) {
     sweetness_level_ = sweetness_level;
+    renewStateId();
 }
 
 /**
@@ -65,6 +68,7 @@ int Dessert::getSweetnessLevel() const {
  */
 void Dessert::setContainsNuts(const bool &contains_nuts) {
     contains_nuts_ = contains_nuts;
+    renewStateId();
 }
 
 /**
@@ -75,6 +79,13 @@ bool Dessert::containsNuts() const {
 }
 
 
+/**
+ * @return A new copy of this dessert, owned by the caller.
+ */
+Dessert* Dessert::clone() const {
+    return new Dessert(*this);
+}
+
 /**
 * Displays the dessert's details.
 * @post Outputs the dessert's details, including name, ingredients,
@@ -141,8 +152,27 @@ needs.
 * - Removes dairy and egg ingredients from `ingredients_`.
 * Dairy and egg ingredients are: "Milk", "Eggs", "Cheese",
 "Butter", "Cream", "Yogurt".
+* Results are memoized in AccommodationCache by the dish and the request.
+Repeating the request on the unchanged result returns at once when it
+would change nothing, and the ingredients are only re-filtered after the
+dish has been changed since.
 */
 void Dessert::dietaryAccommodations(const DietaryRequest& request) {
+    AccommodationCache::Result cached;
+    switch (AccommodationCache::find(this, request, cached)) {
+        case AccommodationCache::ALREADY_APPLIED:
+            return;
+        case AccommodationCache::CACHED_RESULT:
+            setIngredients(cached.ingredients);
+            contains_nuts_ = cached.flag;
+            sweetness_level_ = cached.level;
+            restoreStateId(cached.output_state);
+            return;
+        case AccommodationCache::MISS:
+            break;
+    }
+    const unsigned long long input_state = getStateId();
+
     std::vector<std::string> new_ingredients;
     bool need_update = false;
 
@@ -206,4 +236,7 @@ void Dessert::dietaryAccommodations(const DietaryRequest& request) {
     if (need_update) {
         setIngredients(new_ingredients);
     }
+
+    renewStateId();
+    AccommodationCache::insert(request, {input_state, getStateId(), !request.low_sugar || sweetness_level_ == 0, getIngredientList(), sweetness_level_, contains_nuts_});
 }
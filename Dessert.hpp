@@ -41,6 +41,11 @@ public:
 
     void display() const override;
     void dietaryAccommodations(const DietaryRequest& request) override;
+
+    /**
+     * @return A new copy of this dessert, owned by the caller.
+     */
+    Dessert* clone() const override;
     
     /**
      * Sets the flavor profile of the dessert.
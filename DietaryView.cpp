@@ -0,0 +1,89 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#include "DietaryView.hpp"
+
+/**
+ * Parameterized constructor.
+ * @param base The dish to view.
+ * @param request The accommodation to apply.
+ */
+DietaryView::DietaryView(const Dish* base, const Dish::DietaryRequest& request)
+    : base_(base), request_(request), variant_() {}
+
+/**
+ * @return The unmodified dish this view is based on.
+ */
+const Dish* DietaryView::getBase() const {
+    return base_;
+}
+
+/**
+ * @return The accommodation applied by this view.
+ */
+Dish::DietaryRequest DietaryView::getRequest() const {
+    return request_;
+}
+
+/**
+ * @return True if the accommodated copy has been created.
+ */
+bool DietaryView::isMaterialized() const {
+    return variant_ != nullptr;
+}
+
+/**
+ * @brief Returns the accommodated dish, copying the base dish on first use.
+ *
+ * @return const Dish& The accommodated copy, or the base dish if the request is empty.
+ */
+const Dish& DietaryView::getDish() const {
+    if (!changesDish()) {
+        return *base_;
+    }
+    if (variant_ == nullptr) {
+        Dish* variant = base_->clone();
+        variant->dietaryAccommodations(request_);
+        variant_.reset(variant);
+    }
+    return *variant_;
+}
+
+std::string DietaryView::getName() const {
+    return base_->getName();
+}
+
+int DietaryView::getPrepTime() const {
+    return base_->getPrepTime();
+}
+
+double DietaryView::getPrice() const {
+    return base_->getPrice();
+}
+
+std::string DietaryView::getCuisineType() const {
+    return base_->getCuisineType();
+}
+
+/**
+ * @return The ingredients after the accommodation.
+ */
+std::vector<std::string> DietaryView::getIngredients() const {
+    return getDish().getIngredients();
+}
+
+/**
+ * Displays the accommodated dish.
+ */
+void DietaryView::display() const {
+    getDish().display();
+}
+
+/**
+ * @return True if any field of the request is set.
+ */
+bool DietaryView::changesDish() const {
+    return request_.vegetarian || request_.vegan || request_.gluten_free ||
+           request_.nut_free || request_.low_sodium || request_.low_sugar;
+}
@@ -0,0 +1,82 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#ifndef DIETARY_VIEW_HPP
+#define DIETARY_VIEW_HPP
+
+#include "Dish.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class DietaryView
+ * @brief A read-only view of a dish as it would be after a dietary accommodation.
+ *
+ * The view only holds a pointer to the base dish and the request. The
+ * accommodated dish is materialized on the first call that needs it, as a
+ * private copy with dietaryAccommodations() applied; the base dish is never
+ * modified. Name, preparation time, price and cuisine type are not affected
+ * by accommodations and are always read from the base dish.
+ *
+ * Copies of a view share the materialized dish. A view must not outlive its
+ * base dish, and a single view is not safe to materialize from several
+ * threads at once; views over the same base dish are independent.
+ */
+class DietaryView {
+public:
+    /**
+     * @param base The dish to view. It is not copied until needed.
+     * @param request The accommodation to apply.
+     */
+    DietaryView(const Dish* base, const Dish::DietaryRequest& request);
+
+    /**
+     * @return The unmodified dish this view is based on.
+     */
+    const Dish* getBase() const;
+
+    /**
+     * @return The accommodation applied by this view.
+     */
+    Dish::DietaryRequest getRequest() const;
+
+    /**
+     * @return True if the accommodated copy has been created.
+     */
+    bool isMaterialized() const;
+
+    /**
+     * @return The accommodated dish, creating it on first use. If the request
+     *         asks for no accommodation, this is the base dish itself.
+     */
+    const Dish& getDish() const;
+
+    std::string getName() const;
+    int getPrepTime() const;
+    double getPrice() const;
+    std::string getCuisineType() const;
+
+    /**
+     * @return The ingredients after the accommodation.
+     */
+    std::vector<std::string> getIngredients() const;
+
+    /**
+     * Displays the accommodated dish.
+     */
+    void display() const;
+
+private:
+    const Dish* base_;
+    Dish::DietaryRequest request_;
+    mutable std::shared_ptr<const Dish> variant_;
+
+    /**
+     * @return True if the request asks for at least one accommodation.
+     */
+    bool changesDish() const;
+};
+
+#endif // DIETARY_VIEW_HPP
@@ -3,15 +3,20 @@
  * @author [Farhana Sultana]
  */
 #include "Dish.hpp"
+#include <atomic>
+
+namespace {
+    std::atomic<unsigned long long> next_state_id(1);
+}
 
 // Default Constructor
-Dish::Dish() 
-    : name_("UNKNOWN"), ingredients_({}), prep_time_(0), price_(0.0), cuisine_type_(CuisineType::OTHER) {
+Dish::Dish(const DishKind& kind)
+    : name_("UNKNOWN"), ingredients_(), prep_time_(0), price_(0.0), cuisine_type_(CuisineType::OTHER), kind_(kind), state_id_(next_state_id++) {
 }
 
 // Parameterized Constructor
-Dish::Dish(const std::string& name, const std::vector<std::string>& ingredients, int prep_time, double price, CuisineType cuisine_type)
-    : ingredients_(ingredients), prep_time_(prep_time), price_(price), cuisine_type_(cuisine_type) {
+Dish::Dish(const DishKind& kind, const std::string& name, const std::vector<std::string>& ingredients, int prep_time, double price, CuisineType cuisine_type)
+    : ingredients_(ingredients), prep_time_(prep_time), price_(price), cuisine_type_(cuisine_type), kind_(kind), state_id_(next_state_id++) {
     setName(name);  // Use setName to validate the name
 }
 
@@ -24,6 +29,14 @@ std::vector<std::string> Dish::getIngredients() const {
     return ingredients_;
 }
 
+int Dish::getIngredientCount() const {
+    return ingredients_.size();
+}
+
+const Dish::IngredientList& Dish::getIngredientList() const {
+    return ingredients_;
+}
+
 int Dish::getPrepTime() const {
     return prep_time_;
 }
@@ -44,6 +57,22 @@ std::string Dish::getCuisineType() const {
     }
 }
 
+Dish::DishKind Dish::getKind() const {
+    return kind_;
+}
+
+unsigned long long Dish::getStateId() const {
+    return state_id_;
+}
+
+void Dish::renewStateId() {
+    state_id_ = next_state_id++;
+}
+
+void Dish::restoreStateId(const unsigned long long& state_id) {
+    state_id_ = state_id;
+}
+
 // Mutator Functions
 void Dish::setName(const std::string& name) {
     if (isValidName(name)) {
@@ -51,26 +80,31 @@ void Dish::setName(const std::string& name) {
     } else {
         name_ = "UNKNOWN";
     }
+    renewStateId();
 }
 
 void Dish::setIngredients(const std::vector<std::string>& ingredients) {
     ingredients_ = ingredients;
+    renewStateId();
 }
 
 void Dish::setPrepTime(const int& prep_time) {
     prep_time_ = prep_time;
+    renewStateId();
 }
 
 void Dish::setPrice(const double& price) {
     price_ = price;
+    renewStateId();
 }
 
 void Dish::setCuisineType(const CuisineType& cuisine_type) {
     cuisine_type_ = cuisine_type;
+    renewStateId();
 }
 
 // Helper function to check if the name is valid
-bool Dish::isValidName(const std::string& name) const {
+bool Dish::isValidName(const std::string& name) {
     for (char c : name) {
         if (!std::isalpha(c) && !std::isspace(c)) {  // Check if each character is a letter or space
             return false;  // Name contains non-alphabetic characters other than spaces
@@ -10,12 +10,19 @@
 #include <iostream>
 #include <iomanip> // For std::fixed and std::setprecision
 #include <cctype>  // For std::isalpha, std::isspace
+#include "SmallVector.hpp"
 
 class Dish {
 public:
     // CuisineType enum definition
     enum CuisineType { ITALIAN, MEXICAN, CHINESE, INDIAN, AMERICAN, FRENCH, OTHER };
 
+    /**
+     * The concrete subclass of a dish, stored in every Dish so callers can
+     * branch on it or static_cast without a dynamic_cast or virtual call.
+     */
+    enum DishKind { APPETIZER, MAIN_COURSE, DESSERT };
+
     /**
     * Structure to store dietary accommodation details.
     */
@@ -31,6 +38,7 @@ public:
     // Constructors
     /**
      * Default constructor.
+     * @param kind The subclass being constructed.
      * Initializes all private members with default values:
      * - name: "UNKNOWN"
      * - ingredients: Empty list
@@ -38,12 +46,13 @@ public:
      * - price: 0.0
      * - cuisine_type: OTHER
      */
-    Dish();
+    explicit Dish(const DishKind& kind);
 
 
 
     /**
      * Parameterized constructor.
+     * @param kind The subclass being constructed.
      * @param name A reference to the name of the dish.
      * @param ingredients A reference to a list of ingredients (default is an empty list).
      * @param prep_time The preparation time in minutes (default is 0).
@@ -51,7 +60,7 @@ public:
      * @param cuisine_type The cuisine type of the dish (a CuisineType enum) with default value OTHER.
      * @post The private members are set to the values of the corresponding parameters.
      */
-    Dish(const std::string& name, const std::vector<std::string>& ingredients = {}, int prep_time = 0, double price = 0.0, CuisineType cuisine_type = CuisineType::OTHER);
+    Dish(const DishKind& kind, const std::string& name, const std::vector<std::string>& ingredients = {}, int prep_time = 0, double price = 0.0, CuisineType cuisine_type = CuisineType::OTHER);
 
     // Virtual destructor for proper cleanup in derived classes
     virtual ~Dish() = default;
@@ -67,6 +76,11 @@ public:
      */
     std::vector<std::string> getIngredients() const;
 
+    /**
+     * @return The number of ingredients, without copying the list.
+     */
+    int getIngredientCount() const;
+
     /**
      * @return The preparation time in minutes.
      */
@@ -82,6 +96,17 @@ public:
      */
     std::string getCuisineType() const;
 
+    /**
+     * @return Which subclass the dish is.
+     */
+    DishKind getKind() const;
+
+    /**
+     * @return An id for the dish's current contents. It is shared by copies of
+     *         the dish and replaced by a new, never reused id whenever a mutator runs.
+     */
+    unsigned long long getStateId() const;
+
     // Mutators
     /**
      * Sets the name of the dish.
@@ -133,6 +158,12 @@ public:
      */
     virtual void dietaryAccommodations(const DietaryRequest& request) = 0;
 
+    /**
+     * Creates a copy of the dish with the same dynamic type.
+     * @return A new dish owned by the caller.
+     */
+    virtual Dish* clone() const = 0;
+
     /**
      @param : A const reference to the right-hand side of the `==` operator.
     @return : Returns true if the right-hand side dish is "equal", false
@@ -151,20 +182,46 @@ public:
     */
     bool operator!=(const Dish& rhs) const; // Overloading the != operator
 
-private:
-    std::string name_;
-    std::vector<std::string> ingredients_;
-    int prep_time_;
-    double price_;
-    CuisineType cuisine_type_;
-
     // Helper function to check if the name is valid
     /**
-     * Checks if the name is valid.
+     * Checks if the name is valid. setName() stores "UNKNOWN" for invalid names.
      * @param name The name to be validated.
      * @return True if the name contains only alphabetic characters and spaces; false otherwise.
      */
-    bool isValidName(const std::string& name) const;
+    static bool isValidName(const std::string& name);
+
+    /**
+     * Ingredient storage. Lists of up to 8 ingredients are kept inside the Dish
+     * itself; std::string keeps short names inline as well, so a typical dish
+     * needs no heap allocation for its ingredients.
+     */
+    typedef SmallVector<std::string, 8> IngredientList;
+
+    /**
+     * @return The ingredients, without copying them.
+     */
+    const IngredientList& getIngredientList() const;
+
+protected:
+    /**
+     * Gives the dish a new state id. Called by every mutator.
+     */
+    void renewStateId();
+
+    /**
+     * Gives the dish a state id it had before, when its contents have been put
+     * back exactly as they were then. Used to replay a memoized accommodation.
+     */
+    void restoreStateId(const unsigned long long& state_id);
+
+private:
+    std::string name_;
+    IngredientList ingredients_;
+    int prep_time_;
+    double price_;
+    CuisineType cuisine_type_;
+    DishKind kind_;
+    unsigned long long state_id_;
 };
 
 #endif // DISH_HPP
@@ -0,0 +1,191 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#include "JsonWriter.hpp"
+#include <charconv>
+#include <cmath>
+
+/**
+ * @brief Creates a writer with an empty buffer of the given size.
+ *
+ * @param out The stream the JSON text is written to.
+ * @param buffer_bytes How much text to collect before writing to the stream.
+ */
+JsonWriter::JsonWriter(std::ostream& out, const std::size_t& buffer_bytes)
+    : out_(out), buffer_(buffer_bytes < 64 ? 64 : buffer_bytes), size_(0), after_key_(false) {}
+
+JsonWriter::~JsonWriter() {
+    flush();
+}
+
+void JsonWriter::beginObject() {
+    separate();
+    raw("{");
+    has_members_.push_back(false);
+}
+
+void JsonWriter::endObject() {
+    has_members_.pop_back();
+    raw("}");
+}
+
+void JsonWriter::beginArray() {
+    separate();
+    raw("[");
+    has_members_.push_back(false);
+}
+
+void JsonWriter::endArray() {
+    has_members_.pop_back();
+    raw("]");
+}
+
+void JsonWriter::key(std::string_view name) {
+    separate();
+    char* first = reserve(name.size() + 3);
+    first[0] = '"';
+    std::memcpy(first + 1, name.data(), name.size());
+    first[name.size() + 1] = '"';
+    first[name.size() + 2] = ':';
+    size_ += name.size() + 3;
+    after_key_ = true;
+}
+
+void JsonWriter::string(std::string_view text) {
+    separate();
+    quoted(text);
+}
+
+void JsonWriter::integer(const long long& number) {
+    separate();
+    char* first = reserve(24);
+    size_ = std::to_chars(first, first + 24, number).ptr - buffer_.data();
+}
+
+void JsonWriter::number(const double& number) {
+    if (!std::isfinite(number)) {
+        null();
+        return;
+    }
+    separate();
+    char* first = reserve(32);
+    size_ = std::to_chars(first, first + 32, number).ptr - buffer_.data();
+}
+
+void JsonWriter::boolean(const bool& flag) {
+    separate();
+    raw(flag ? "true" : "false");
+}
+
+void JsonWriter::null() {
+    separate();
+    raw("null");
+}
+
+/**
+ * @brief Hands the buffered text to the stream.
+ *
+ * @return bool True if the stream is still good.
+ */
+bool JsonWriter::flush() {
+    if (size_ > 0) {
+        out_.write(buffer_.data(), size_);
+        size_ = 0;
+    }
+    return bool(out_);
+}
+
+/**
+ * @brief Writes a comma unless the value is the first in its scope or follows a key.
+ */
+void JsonWriter::separate() {
+    if (after_key_) {
+        after_key_ = false;
+        return;
+    }
+    if (!has_members_.empty()) {
+        if (has_members_.back()) {
+            raw(",");
+        }
+        has_members_.back() = true;
+    }
+}
+
+/**
+ * @brief Flushes if fewer than bytes characters are free.
+ *
+ * @param bytes The number of characters about to be written; at most the buffer size.
+ * @return char* Where to write them.
+ */
+char* JsonWriter::reserve(const std::size_t& bytes) {
+    if (buffer_.size() - size_ < bytes) {
+        flush();
+    }
+    return buffer_.data() + size_;
+}
+
+/**
+ * @brief Appends text that does not fit in the free space, flushing first.
+ *
+ * @param text The text to append.
+ */
+void JsonWriter::rawSlow(std::string_view text) {
+    flush();
+    if (text.size() > buffer_.size()) {
+        out_.write(text.data(), text.size());
+        return;
+    }
+    std::memcpy(buffer_.data(), text.data(), text.size());
+    size_ = text.size();
+}
+
+/**
+ * @brief Writes a string literal, escaping quotes, backslashes and control characters.
+ *
+ * Strings that need no escaping, which is nearly all of them, are copied
+ * with their quotes in one piece; otherwise each run of characters between
+ * escapes is.
+ *
+ * @param text The string to write.
+ */
+void JsonWriter::quoted(std::string_view text) {
+    static const char hex[] = "0123456789abcdef";
+    bool plain = true;
+    for (char ch : text) {
+        unsigned char c = static_cast<unsigned char>(ch);
+        plain = plain && c >= 0x20 && c != '"' && c != '\\';
+    }
+    if (plain && text.size() + 2 <= buffer_.size()) {
+        char* first = reserve(text.size() + 2);
+        first[0] = '"';
+        std::memcpy(first + 1, text.data(), text.size());
+        first[text.size() + 1] = '"';
+        size_ += text.size() + 2;
+        return;
+    }
+
+    raw("\"");
+    std::size_t start = 0;
+    for (std::size_t i = 0; i < text.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        raw(text.substr(start, i - start));
+        switch (c) {
+            case '"': raw("\\\""); break;
+            case '\\': raw("\\\\"); break;
+            case '\n': raw("\\n"); break;
+            case '\r': raw("\\r"); break;
+            case '\t': raw("\\t"); break;
+            default: {
+                char escape[] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF]};
+                raw(std::string_view(escape, sizeof(escape)));
+            }
+        }
+        start = i + 1;
+    }
+    raw(text.substr(start));
+    raw("\"");
+}
@@ -0,0 +1,102 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#ifndef JSON_WRITER_HPP
+#define JSON_WRITER_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class JsonWriter
+ * @brief Writes JSON text straight into a buffered output stream.
+ *
+ * Values are written as they are given, so no document tree is ever
+ * built: memory use is the buffer plus one flag per open object or array.
+ * Commas and the colon after a key are inserted automatically. Numbers are
+ * formatted with std::to_chars, which gives the shortest text that reads
+ * back to the same double and does not depend on the locale. The buffer
+ * is handed to the stream in large blocks.
+ */
+class JsonWriter {
+public:
+    /**
+     * @param out The stream the JSON text is written to.
+     * @param buffer_bytes How much text to collect before writing to the stream.
+     */
+    explicit JsonWriter(std::ostream& out, const std::size_t& buffer_bytes = 1 << 20);
+
+    /**
+     * Writes any text still buffered.
+     */
+    ~JsonWriter();
+
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+
+    /**
+     * Writes an object member name. The next value written is its value.
+     * @param name The member name; written as is, so it must not need escaping.
+     */
+    void key(std::string_view name);
+
+    void string(std::string_view text);
+    void integer(const long long& number);
+
+    /**
+     * Writes a number, or null for NaN and infinities, which JSON cannot represent.
+     */
+    void number(const double& number);
+
+    void boolean(const bool& flag);
+    void null();
+
+    /**
+     * Writes the buffered text to the stream.
+     * @return True if the stream is still good.
+     */
+    bool flush();
+
+private:
+    std::ostream& out_;
+    std::vector<char> buffer_;
+    std::size_t size_;              ///< Bytes of buffer_ in use.
+    std::vector<bool> has_members_; ///< One entry per open object or array: true once it holds a value.
+    bool after_key_;                ///< True between key() and the value that follows it.
+
+    /**
+     * Helper function to write the comma that separates a value from the one before it
+     */
+    void separate();
+
+    /**
+     * Helper function to make room for at least bytes more characters
+     */
+    char* reserve(const std::size_t& bytes);
+
+    /**
+     * Helper function to append text that needs no escaping
+     */
+    void raw(std::string_view text) {
+        if (buffer_.size() - size_ >= text.size()) {
+            std::memcpy(buffer_.data() + size_, text.data(), text.size());
+            size_ += text.size();
+        } else {
+            rawSlow(text);
+        }
+    }
+
+    void rawSlow(std::string_view text);
+    void quoted(std::string_view text);
+};
+
+#endif // JSON_WRITER_HPP
@@ -3,6 +3,138 @@
  * @author [Farhana Sultana]
  */
 #include "Kitchen.hpp"
+#include "AccommodationCache.hpp"
+#include "ColumnarFile.hpp"
+#include "OrderLog.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <iterator>
+#include <thread>
+#include <utility>
+
+namespace {
+    const std::size_t PARALLEL_SORT_GRAIN = 1 << 15;  ///< Minimum entries per sorting thread.
+
+    /**
+     * Sorts (key, index) pairs. Large inputs are cut into one run per hardware
+     * thread; each run is sorted on its own thread and neighbouring runs are
+     * then merged pairwise, also in parallel, until one run is left.
+     */
+    template <class Entry>
+    void parallelSort(std::vector<Entry>& entries) {
+        std::size_t threads = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()),
+                                                    entries.size() / PARALLEL_SORT_GRAIN);
+        if (threads <= 1) {
+            std::sort(entries.begin(), entries.end());
+            return;
+        }
+
+        auto begin = entries.begin();
+        std::vector<std::size_t> bounds(threads + 1);
+        for (std::size_t i = 0; i <= threads; i++) {
+            bounds[i] = entries.size() * i / threads;
+        }
+        std::vector<std::thread> workers;
+        for (std::size_t i = 0; i < threads; i++) {
+            workers.emplace_back([begin, first = bounds[i], last = bounds[i + 1]] {
+                std::sort(begin + first, begin + last);
+            });
+        }
+        for (auto& worker : workers) worker.join();
+
+        while (bounds.size() > 2) {
+            std::vector<std::size_t> merged;
+            workers.clear();
+            for (std::size_t i = 0; i + 2 < bounds.size(); i += 2) {
+                workers.emplace_back([begin, first = bounds[i], middle = bounds[i + 1], last = bounds[i + 2]] {
+                    std::inplace_merge(begin + first, begin + middle, begin + last);
+                });
+                merged.push_back(bounds[i]);
+            }
+            if (bounds.size() % 2 == 0) {
+                merged.push_back(bounds[bounds.size() - 2]);  // An odd run out waits for the next round.
+            }
+            merged.push_back(bounds.back());
+            for (auto& worker : workers) worker.join();
+            bounds.swap(merged);
+        }
+    }
+
+    /**
+     * Returns true unless ingredients[i] also appears earlier in the list.
+     * Ingredient lists are short, so the quadratic scan is cheaper than a set.
+     */
+    bool isFirstOccurrence(const Dish::IngredientList& ingredients, size_t i) {
+        for (size_t j = 0; j < i; j++) {
+            if (ingredients[j] == ingredients[i]) return false;
+        }
+        return true;
+    }
+
+    /**
+     * Returns the sort key of a price. NaN, which a dish can only get through
+     * setPrice(), compares false with everything and would make std::sort
+     * undefined, so it is ordered last, together with infinity.
+     */
+    double priceSortKey(double price) {
+        return std::isnan(price) ? HUGE_VAL : price;
+    }
+
+    /**
+     * Adds a dish's contribution to report figures (sign 1) or takes it away (sign -1).
+     */
+    void countDish(Kitchen::ReportSummary& summary, const Dish* dish, const int& sign) {
+        summary.cuisine_tally[Kitchen::stringToCuisineType(dish->getCuisineType())] += sign;
+        summary.dish_count += sign;
+        summary.prep_time_sum += sign * dish->getPrepTime();
+        summary.price_sum += sign * dish->getPrice();
+        if (dish->getIngredientCount() >= 5 && dish->getPrepTime() >= 60) {
+            summary.elaborate_count += sign;
+        }
+    }
+
+    const int MAX_BITMAPS_PER_DISH = 5;  ///< Kind, attribute, cuisine, price and prep time bitmaps.
+
+    const std::size_t PARALLEL_REDUCE_GRAIN = 1 << 14;        ///< Entries per reduction chunk.
+    const std::size_t PARALLEL_REDUCE_PER_THREAD = 1 << 16;   ///< Minimum entries per reducing thread.
+
+    /**
+     * Reduces the indices [0, count). The range is cut into fixed chunks of
+     * PARALLEL_REDUCE_GRAIN indices; reduce(first, last) returns the partial
+     * result of one chunk and combine(total, partial) folds the partials in
+     * chunk order. The chunking depends only on count, so the result, even a
+     * floating-point sum, is the same whatever the number of threads. The
+     * chunks are dealt round-robin to at most one thread per hardware thread,
+     * and to no extra thread at all below PARALLEL_REDUCE_PER_THREAD entries
+     * per thread, where starting one would cost more than it saves.
+     */
+    template <class Result, class Reduce, class Combine>
+    Result parallelReduce(std::size_t count, Result total, Reduce reduce, Combine combine) {
+        std::size_t chunks = (count + PARALLEL_REDUCE_GRAIN - 1) / PARALLEL_REDUCE_GRAIN;
+        std::size_t threads = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()),
+                                                    count / PARALLEL_REDUCE_PER_THREAD);
+        std::vector<Result> partials(chunks, Result());
+        auto work = [&](std::size_t first_chunk, std::size_t stride) {
+            for (std::size_t c = first_chunk; c < chunks; c += stride) {
+                partials[c] = reduce(c * PARALLEL_REDUCE_GRAIN, std::min(count, (c + 1) * PARALLEL_REDUCE_GRAIN));
+            }
+        };
+        if (threads <= 1) {
+            work(0, 1);
+        } else {
+            std::vector<std::thread> workers;
+            for (std::size_t t = 0; t < threads; t++) {
+                workers.emplace_back(work, t, threads);
+            }
+            for (auto& worker : workers) worker.join();
+        }
+        for (const Result& partial : partials) {
+            combine(total, partial);
+        }
+        return total;
+    }
+}
 
 /**
  * @brief Constructs a new Kitchen object.
@@ -10,7 +142,7 @@
  * Initializes a new instance of the Kitchen class, which inherits from ArrayBag<Dish*>.
  * The constructor sets the total preparation time and the count of elaborate dishes to zero.
  */
-Kitchen::Kitchen() : ArrayBag<Dish*>(), total_prep_time_(0), count_elaborate_(0) {}
+Kitchen::Kitchen() : ArrayBag<Dish*>(), totals_(), source_offset_(0), source_line_(0), order_log_(nullptr), sorted_views_valid_(0) {}
 
 
 /**
@@ -25,7 +157,7 @@ Kitchen::Kitchen() : ArrayBag<Dish*>(), total_prep_time_(0), count_elaborate_(0)
  * @return Appetizer::ServingStyle The corresponding enum value for the given string.
  *         Defaults to Appetizer::PLATED if the input string does not match any known serving style.
  */
-Appetizer::ServingStyle stringToServingStyle(const std::string& str) {
+Appetizer::ServingStyle stringToServingStyle(std::string_view str) {
     if (str == "PLATED") return Appetizer::PLATED;
     if (str == "BUFFET") return Appetizer::BUFFET;
     if (str == "FAMILY_STYLE") return Appetizer::FAMILY_STYLE;
@@ -43,7 +175,7 @@ Appetizer::ServingStyle stringToServingStyle(const std::string& str) {
  *            Possible values are: "GRILLED", "BAKED", "BOILED", "FRIED", "STEAMED", "RAW".
  * @return MainCourse::CookingMethod The corresponding enum value for the given string.
  */
-MainCourse::CookingMethod stringToCookingMethod(const std::string& str) {
+MainCourse::CookingMethod stringToCookingMethod(std::string_view str) {
     if (str == "GRILLED") return MainCourse::GRILLED;
     if (str == "BAKED") return MainCourse::BAKED;
     if (str == "BOILED") return MainCourse::BOILED;
@@ -60,7 +192,7 @@ MainCourse::CookingMethod stringToCookingMethod(const std::string& str) {
  * @param str The string representation of the flavor profile. Expected values are "SWEET", "BITTER", "SOUR", "SALTY", or "UMAMI".
  * @return Dessert::FlavorProfile The corresponding Dessert::FlavorProfile enum value. Defaults to Dessert::SWEET if the input string does not match any known flavor profile.
  */
-Dessert::FlavorProfile stringToFlavorProfile(const std::string& str) {
+Dessert::FlavorProfile stringToFlavorProfile(std::string_view str) {
     if (str == "SWEET") return Dessert::SWEET;
     if (str == "BITTER") return Dessert::BITTER;
     if (str == "SOUR") return Dessert::SOUR;
@@ -69,74 +201,362 @@ Dessert::FlavorProfile stringToFlavorProfile(const std::string& str) {
     return Dessert::SWEET;  // default
 }
 
+namespace {
+    // Enum spellings used by the menu CSV, indexed by enum value
+    const char* const DISH_TYPE_NAMES[] = {"APPETIZER", "MAINCOURSE", "DESSERT"};
+    const char* const SERVING_STYLE_NAMES[] = {"PLATED", "FAMILY_STYLE", "BUFFET"};
+    const char* const COOKING_METHOD_NAMES[] = {"GRILLED", "BAKED", "BOILED", "FRIED", "STEAMED", "RAW"};
+    const char* const CATEGORY_NAMES[] = {"GRAIN", "PASTA", "LEGUME", "BREAD", "SALAD", "SOUP", "STARCHES", "VEGETABLE"};
+    const char* const FLAVOR_PROFILE_NAMES[] = {"SWEET", "BITTER", "SOUR", "SALTY", "UMAMI"};
+}
+
+/**
+ * @brief Parses a whole number from the start of a CSV field.
+ *
+ * Follows the same rules as std::stoi: leading whitespace and a '+' sign are
+ * allowed and anything after the number is ignored. Uses std::from_chars, so
+ * it does not depend on the locale, allocate or throw.
+ *
+ * @param field The field to parse.
+ * @param value Receives the number on success.
+ * @return true if the field starts with a number that fits in an int.
+ */
+bool parseInt(std::string_view field, int& value) {
+    size_t start = 0;
+    while (start < field.size() && std::isspace(static_cast<unsigned char>(field[start]))) start++;
+    if (start + 1 < field.size() && field[start] == '+' && field[start + 1] != '-') start++;
+    const char* first = field.data() + start;
+    return std::from_chars(first, field.data() + field.size(), value).ec == std::errc();
+}
+
+/**
+ * @brief Parses a decimal number from the start of a CSV field.
+ *
+ * Follows the same rules as std::stod for decimal input; see parseInt().
+ * Unlike std::stod, "nan" and "inf" are rejected: a non-finite price has no
+ * place in the ordered indexes.
+ *
+ * @param field The field to parse.
+ * @param value Receives the number on success.
+ * @return true if the field starts with a finite number in the range of double.
+ */
+bool parseDouble(std::string_view field, double& value) {
+    size_t start = 0;
+    while (start < field.size() && std::isspace(static_cast<unsigned char>(field[start]))) start++;
+    if (start + 1 < field.size() && field[start] == '+' && field[start + 1] != '-') start++;
+    const char* first = field.data() + start;
+    return std::from_chars(first, field.data() + field.size(), value).ec == std::errc() && std::isfinite(value);
+}
+
 /**
 * Parameterized constructor.
 * @param filename The name of the input CSV file containing dish
 information.
+* @param expected_dishes The number of dishes to reserve room for, or a
+negative value to count the lines of the file before parsing.
+* @param print_errors Whether to print the load report to std::cerr if
+any line was rejected.
 * @pre The CSV file must be properly formatted.
 * @post Initializes the kitchen by reading dishes from the CSV file and
-storing them as `Dish*`.
+storing them as `Dish*`. A final line without a newline is loaded like
+the others, but reading resumes before it, so loadAppendedDishes() can
+finish it if it was still being written.
 */
-Kitchen::Kitchen(const std::string& filename) : Kitchen() {
-    std::ifstream file(filename);
+Kitchen::Kitchen(const std::string& filename, const int& expected_dishes, const bool& print_errors) : Kitchen() {
+    std::ifstream file(filename, std::ios::binary);
     if (!file.is_open()) {
         std::cerr << "Error opening file: " << filename << std::endl;
         return;
     }
 
+    if (expected_dishes >= 0) {
+        reserve(expected_dishes);
+    } else {
+        reserve(countLines(file));
+        file.clear();
+        file.seekg(0);
+    }
+
     std::string line;
-    std::getline(file, line);
+    int line_number = 0;
+    int complete_lines = 0;
+    std::streamoff offset = 0;
 
+    DishRecord record;
     while (std::getline(file, line)) {
-        try {
-            std::vector<std::string> tokens = split(line, ',');
-            if (tokens.size() < 7) continue;  
-
-            std::string dish_type = tokens[0];
-            std::string name = tokens[1];
-            std::vector<std::string> ingredients = split(tokens[2], ';');
-            int prep_time = std::stoi(tokens[3]);
-            double price = std::stod(tokens[4]);
-            Dish::CuisineType cuisine_type = stringToCuisineType(tokens[5]);
-            std::vector<std::string> additional_attrs = split(tokens[6], ';');
-
-            Dish* dish = nullptr;
-
-            if (dish_type == "APPETIZER") {
-                Appetizer::ServingStyle serving_style = stringToServingStyle(additional_attrs[0]);
-                int spiciness = std::stoi(additional_attrs[1]);
-                bool vegetarian = additional_attrs[2] == "true";
-                dish = new Appetizer(name, ingredients, prep_time, price, cuisine_type, 
-                                   serving_style, spiciness, vegetarian);
-            }
-            else if (dish_type == "MAINCOURSE") {
-                MainCourse::CookingMethod cooking_method = stringToCookingMethod(additional_attrs[0]);
-                std::string protein = additional_attrs[1];
-                bool gluten_free = additional_attrs[2] == "true";
-                std::vector<MainCourse::SideDish> sides;
-                dish = new MainCourse(name, ingredients, prep_time, price, cuisine_type, 
-                                    cooking_method, protein, sides, gluten_free);
-            }
-            else if (dish_type == "DESSERT") {
-                Dessert::FlavorProfile flavor = stringToFlavorProfile(additional_attrs[0]);
-                int sweetness = std::stoi(additional_attrs[1]);
-                bool contains_nuts = additional_attrs[2] == "true";
-                dish = new Dessert(name, ingredients, prep_time, price, cuisine_type, 
-                                 flavor, sweetness, contains_nuts);
-            }
+        bool complete = !file.eof();
+        if (complete) {
+            offset += line.size() + 1;
+            complete_lines++;
+        }
+        if (++line_number == 1) {
+            continue;  // header
+        }
+        LoadReport::Status status = parseRecord(line, record);
+        load_report_.addLine(line_number, status);
+        if (status == LoadReport::RECORD_OK) {
+            newOrder(makeDish(record));
+        }
+        if (!complete) {
+            source_tail_ = line;
+        }
+    }
+
+    // Remember where the last complete line ended so loadAppendedDishes() can resume there
+    source_file_ = filename;
+    source_offset_ = offset;
+    source_line_ = complete_lines;
+    file.close();
+
+    if (print_errors && load_report_.getErrorCount() > 0) {
+        std::cerr << "Errors loading " << filename << ":\n";
+        load_report_.print(std::cerr);
+    }
+}
 
-            if (dish != nullptr) {
-                newOrder(dish);
+
+/**
+ * @brief Loads the dish lines appended to the source CSV since it was last read.
+ *
+ * Reading starts at the byte offset where the previous read stopped, so only
+ * the new lines are parsed. A final line without a newline is assumed to be
+ * still being written and is left for the next call. The unterminated line
+ * the constructor loaded is skipped once it is completed unchanged; if more
+ * was written to it, the completed line is loaded as well. If the file has
+ * become shorter than the saved offset it is treated as replaced and read
+ * again from the start, header included. Each line's outcome is added to
+ * getLoadReport().
+ *
+ * @return int The number of dishes added, or -1 if the kitchen has no source
+ *         file or the file cannot be opened.
+ */
+int Kitchen::loadAppendedDishes() {
+    if (source_file_.empty()) {
+        return -1;
+    }
+    std::ifstream file(source_file_, std::ios::binary);
+    if (!file.is_open()) {
+        return -1;
+    }
+    std::streamoff file_size = file.seekg(0, std::ios::end).tellg();
+    if (file_size < source_offset_) {
+        source_offset_ = 0;
+        source_line_ = 0;
+        source_tail_.clear();
+    }
+    file.seekg(source_offset_);
+
+    int added = 0;
+    std::string line;
+    DishRecord record;
+    while (std::getline(file, line)) {
+        if (file.eof()) {
+            break;  // unterminated last line
+        }
+        source_offset_ += line.size() + 1;
+        if (++source_line_ == 1) {
+            continue;  // header
+        }
+        if (!source_tail_.empty()) {
+            bool loaded = line == source_tail_;
+            source_tail_.clear();
+            if (loaded) {
+                continue;  // the constructor already loaded this line
             }
         }
-        catch (const std::exception& e) {
-            std::cerr << "Error processing line: " << line << "\nError: " << e.what() << std::endl;
-            continue;
+        LoadReport::Status status = parseRecord(line, record);
+        load_report_.addLine(source_line_, status);
+        if (status == LoadReport::RECORD_OK && newOrder(makeDish(record))) {
+            added++;
         }
     }
-    file.close();
+    return added;
+}
+
+/**
+ * @brief Attaches or detaches the write-ahead log.
+ *
+ * Dishes already in the kitchen are not logged; the log only records the
+ * mutations made after it is attached.
+ *
+ * @param order_log The log to write to, or nullptr to stop logging.
+ */
+void Kitchen::attachOrderLog(OrderLog* order_log) {
+    order_log_ = order_log;
+}
+
+/**
+ * @return OrderLog* The attached write-ahead log, or nullptr.
+ */
+OrderLog* Kitchen::getOrderLog() const {
+    return order_log_;
+}
+
+/**
+ * @brief Counts the data lines of a CSV stream.
+ *
+ * Reads the stream in large blocks and counts newline characters, which is
+ * much cheaper than parsing, so the caller can size the bag once up front.
+ * The header line is not counted.
+ *
+ * @param input The stream to scan; it is left at end-of-file.
+ * @return int The number of lines after the header.
+ */
+int Kitchen::countLines(std::istream& input) {
+    static const std::streamsize BLOCK_SIZE = 1 << 16;
+    std::vector<char> block(BLOCK_SIZE);
+    long long lines = 0;
+    char last = '\n';
+    while (input.read(block.data(), BLOCK_SIZE) || input.gcount() > 0) {
+        std::streamsize read = input.gcount();
+        lines += std::count(block.begin(), block.begin() + read, '\n');
+        last = block[read - 1];
+    }
+    if (last != '\n') {
+        lines++;  // final line without a trailing newline
+    }
+    return lines > 0 ? int(lines - 1) : 0;
 }
 
+/**
+ * @brief Parses one line of the menu CSV.
+ *
+ * Columns are dish_type, name, ';'-separated ingredients, prep_time, price,
+ * cuisine_type and ';'-separated dish-specific attributes. Both the CSV
+ * constructor and streamReport() go through this function so they accept
+ * and reject exactly the same rows.
+ *
+ * Fields are split as string_views into the line and numbers are parsed
+ * with std::from_chars, so a malformed row costs a status code rather than
+ * an exception, and the record's buffers are reused from line to line.
+ *
+ * @param line The raw CSV line.
+ * @param record The record to fill in.
+ * @return LoadReport::Status RECORD_OK if the record is complete, otherwise why the line was rejected.
+ */
+LoadReport::Status Kitchen::parseRecord(std::string_view line, DishRecord& record) {
+    std::vector<std::string_view>& tokens = record.columns;
+    split(line, ',', tokens);
+    if (tokens.size() < 7) return LoadReport::TOO_FEW_COLUMNS;
+
+    if (!parseInt(tokens[3], record.prep_time) || !parseDouble(tokens[4], record.price)) {
+        return LoadReport::BAD_NUMBER;
+    }
+    std::string_view dish_type = tokens[0];
+    if (dish_type != "APPETIZER" && dish_type != "MAINCOURSE" && dish_type != "DESSERT") {
+        return LoadReport::UNKNOWN_TYPE;
+    }
+
+    record.dish_type.assign(dish_type);
+    record.name.assign(tokens[1]);
+    record.cuisine_type = stringToCuisineType(tokens[5]);
+
+    std::vector<std::string_view>& additional_attrs = record.attributes;
+    split(tokens[6], ';', additional_attrs);
+    split(tokens[2], ';', tokens);  // tokens[6] is no longer needed
+    record.ingredients.assign(tokens.begin(), tokens.end());
+
+    if (additional_attrs.size() < 2) {
+        return LoadReport::MISSING_ATTRIBUTE;
+    }
+    if (dish_type == "APPETIZER") {
+        record.serving_style = stringToServingStyle(additional_attrs[0]);
+        if (!parseInt(additional_attrs[1], record.level)) return LoadReport::BAD_NUMBER;
+    }
+    else if (dish_type == "MAINCOURSE") {
+        record.cooking_method = stringToCookingMethod(additional_attrs[0]);
+        record.protein_type.assign(additional_attrs[1]);
+    }
+    else {
+        record.flavor_profile = stringToFlavorProfile(additional_attrs[0]);
+        if (!parseInt(additional_attrs[1], record.level)) return LoadReport::BAD_NUMBER;
+    }
+    if (additional_attrs.size() < 3) {
+        return LoadReport::MISSING_ATTRIBUTE;
+    }
+    record.flag = additional_attrs[2] == "true";
+    return LoadReport::RECORD_OK;
+}
+
+/**
+ * @brief Allocates the Dish subclass described by a parsed record.
+ *
+ * @param record A record accepted by parseRecord().
+ * @return Dish* A new Appetizer, MainCourse or Dessert owned by the caller.
+ */
+Dish* Kitchen::makeDish(const DishRecord& record) {
+    if (record.dish_type == "APPETIZER") {
+        return new Appetizer(record.name, record.ingredients, record.prep_time, record.price, record.cuisine_type,
+                             record.serving_style, record.level, record.flag);
+    }
+    if (record.dish_type == "MAINCOURSE") {
+        std::vector<MainCourse::SideDish> sides;
+        return new MainCourse(record.name, record.ingredients, record.prep_time, record.price, record.cuisine_type,
+                              record.cooking_method, record.protein_type, sides, record.flag);
+    }
+    return new Dessert(record.name, record.ingredients, record.prep_time, record.price, record.cuisine_type,
+                       record.flavor_profile, record.level, record.flag);
+}
+
+/**
+ * @brief Computes the kitchen report figures from a CSV stream without storing any dish.
+ *
+ * Each row goes through parseRecord(), exactly as in the CSV constructor, and
+ * is folded into running counters before the next row is read. The outcome
+ * of every row is recorded in a LoadReport.
+ *
+ * @param input A stream positioned at the CSV header line.
+ * @param load_report Receives the outcome of every row; if null, a report is
+ *                    printed to std::cerr when some rows were rejected.
+ * @return ReportSummary The tallies, prep time and price sums and elaborate count of all accepted rows.
+ */
+Kitchen::ReportSummary Kitchen::streamReport(std::istream& input, LoadReport* load_report) {
+    ReportSummary summary = {};
+
+    std::string line;
+    std::getline(input, line);
+
+    LoadReport local_report;
+    LoadReport& report = load_report != nullptr ? *load_report : local_report;
+
+    DishRecord record;
+    int line_number = 1;
+    while (std::getline(input, line)) {
+        LoadReport::Status status = parseRecord(line, record);
+        report.addLine(++line_number, status);
+        if (status != LoadReport::RECORD_OK) continue;
+        summary.cuisine_tally[record.cuisine_type]++;
+        summary.dish_count++;
+        summary.prep_time_sum += record.prep_time;
+        summary.price_sum += record.price;
+        if (record.ingredients.size() >= 5 && record.prep_time >= 60) {
+            summary.elaborate_count++;
+        }
+    }
+    if (load_report == nullptr && local_report.getErrorCount() > 0) {
+        local_report.print(std::cerr);
+    }
+    return summary;
+}
+
+/**
+ * @brief Computes the kitchen report figures for a CSV file or standard input.
+ *
+ * @param filename The path of the CSV file, or "-" to read standard input.
+ * @param load_report Receives the outcome of every row, or null to print errors.
+ * @return ReportSummary The figures for all accepted rows; all zero if the file cannot be opened.
+ */
+Kitchen::ReportSummary Kitchen::streamReport(const std::string& filename, LoadReport* load_report) {
+    if (filename == "-") {
+        return streamReport(std::cin, load_report);
+    }
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error opening file: " << filename << std::endl;
+        return ReportSummary{};
+    }
+    return streamReport(file, load_report);
+}
 
 /**
  * @brief Destructor for the Kitchen class.
@@ -164,15 +584,64 @@ Kitchen::~Kitchen() {
  */
 bool Kitchen::newOrder(Dish* new_dish) {
     if (add(new_dish)) {
-        total_prep_time_ += new_dish->getPrepTime();
-        if (new_dish->getIngredients().size() >= 5 && new_dish->getPrepTime() >= 60) {
-            count_elaborate_++;
-        }
+        indexDish(new_dish);
+        updateBitmaps(new_dish, getCurrentSize() - 1, true);
+        if (order_log_ != nullptr) order_log_->logNewOrder(*new_dish);
+        invalidateSortedViews();
+        price_stats_.add(new_dish->getPrice());
+        prep_time_stats_.add(new_dish->getPrepTime());
+        price_sketch_.add(new_dish->getPrice());
+        prep_time_sketch_.add(new_dish->getPrepTime());
+        countDish(totals_, new_dish, 1);
         return true;
     }
     return false;
 }
 
+/**
+ * @brief Adds a batch of dishes to the kitchen's order list.
+ *
+ * @param new_dishes The dishes to add.
+ * @return std::vector<bool> Per-dish success, in the order given.
+ */
+std::vector<bool> Kitchen::newOrders(const std::vector<Dish*>& new_dishes) {
+    return newOrders(new_dishes.data(), new_dishes.data() + new_dishes.size());
+}
+
+/**
+ * @brief Adds the dishes in [first, last) to the kitchen's order list.
+ *
+ * The bag is grown once for the whole batch, every dish is indexed, and the
+ * report totals are accumulated locally and applied once at the end. Null pointers are rejected and reported as false; no
+ * exception is thrown for individual items.
+ *
+ * @param first Pointer to the first dish of the batch.
+ * @param last Pointer one past the last dish of the batch.
+ * @return std::vector<bool> Per-dish success, in the order given.
+ */
+std::vector<bool> Kitchen::newOrders(Dish* const* first, Dish* const* last) {
+    std::vector<bool> added(last - first, false);
+    reserve(getCurrentSize() + int(last - first));
+
+    ReportSummary batch = {};
+    for (Dish* const* dish = first; dish != last; ++dish) {
+        if (*dish == nullptr || !add(*dish)) continue;
+        indexDish(*dish);
+        updateBitmaps(*dish, getCurrentSize() - 1, true);
+        if (order_log_ != nullptr) order_log_->logNewOrder(**dish);
+        int prep_time = (*dish)->getPrepTime();
+        price_stats_.add((*dish)->getPrice());
+        prep_time_stats_.add(prep_time);
+        price_sketch_.add((*dish)->getPrice());
+        prep_time_sketch_.add(prep_time);
+        countDish(batch, *dish, 1);
+        added[dish - first] = true;
+    }
+    mergeSummary(totals_, batch);
+    invalidateSortedViews();
+    return added;
+}
+
 /**
  * @brief Serves a dish by removing it from the kitchen's list of dishes.
  *
@@ -184,19 +653,31 @@ bool Kitchen::newOrder(Dish* new_dish) {
  * dish is also freed.
  *
  * @param dish_to_remove A pointer to the dish to be removed.
- * @return true if the dish was successfully removed, false if the dish was not found.
+ * @return true if the dish was successfully removed, false if the dish was not found
+ *         or is nullptr.
  */
 bool Kitchen::serveDish(const Dish* dish_to_remove) {
-    if (getCurrentSize() == 0) return false;
+    if (getCurrentSize() == 0 || dish_to_remove == nullptr) return false;
 
     for (int i = 0; i < getCurrentSize(); i++) {
         if (*items_[i] == *dish_to_remove) {
-            total_prep_time_ -= items_[i]->getPrepTime();
-            if (items_[i]->getIngredients().size() >= 5 && items_[i]->getPrepTime() >= 60) {
-                count_elaborate_--;
+            countDish(totals_, items_[i], -1);
+            price_stats_.remove(items_[i]->getPrice());
+            prep_time_stats_.remove(items_[i]->getPrepTime());
+            price_sketch_.remove(items_[i]->getPrice());
+            prep_time_sketch_.remove(items_[i]->getPrepTime());
+            unindexDish(items_[i]);
+            // remove() moves the last dish into position i
+            int last = getCurrentSize() - 1;
+            updateBitmaps(items_[i], i, false);
+            if (i != last) {
+                updateBitmaps(items_[last], last, false);
+                updateBitmaps(items_[last], i, true);
             }
+            if (order_log_ != nullptr) order_log_->logServeDish(*items_[i]);
             delete items_[i];  // Free the memory
             remove(items_[i]);
+            invalidateSortedViews();
             return true;
         }
     }
@@ -207,14 +688,75 @@ bool Kitchen::serveDish(const Dish* dish_to_remove) {
  * @brief Adjusts the dietary accommodations for all dishes in the kitchen based on the given dietary request.
  * 
  * This function iterates through all the dishes currently in the kitchen and applies the specified dietary 
- * accommodations to each dish.
+ * accommodations to each dish. Each dish is re-indexed by ingredient since
+ * the accommodations may add, replace or remove ingredients.
+ *
+ * Dishes are processed one kind at a time, so every call in a run goes to
+ * the same, statically bound dietaryAccommodations().
  * 
  * @param request A reference to a DietaryRequest object that specifies the dietary accommodations to be applied.
  */
 void Kitchen::dietaryAdjustment(const Dish::DietaryRequest& request) {
+    if (order_log_ != nullptr) order_log_->logDietaryAdjustment(request);
+    std::vector<int> positions[Dish::DESSERT + 1];
     for (int i = 0; i < getCurrentSize(); i++) {
-        items_[i]->dietaryAccommodations(request);
+        positions[items_[i]->getKind()].push_back(i);
     }
+    for (int i : positions[Dish::APPETIZER]) adjustDish<Appetizer>(i, request);
+    for (int i : positions[Dish::MAIN_COURSE]) adjustDish<MainCourse>(i, request);
+    for (int i : positions[Dish::DESSERT]) adjustDish<Dessert>(i, request);
+    invalidateSortedViews();
+}
+
+/**
+ * @brief Applies an accommodation to one dish and re-indexes it.
+ *
+ * The report totals are updated too, since removing ingredients can make a
+ * dish stop counting as elaborate.
+ *
+ * @tparam DishType The dish's subclass; its dietaryAccommodations() is called directly.
+ * @param position The dish's position in the bag.
+ * @param request The accommodations to apply.
+ */
+template <class DishType>
+void Kitchen::adjustDish(const int& position, const Dish::DietaryRequest& request) {
+    DishType* dish = static_cast<DishType*>(items_[position]);
+    if (AccommodationCache::isApplied(dish, request)) {
+        return;  // Accommodating it again would change nothing.
+    }
+    unindexIngredients(dish);
+    updateBitmaps(dish, position, false);
+    countDish(totals_, dish, -1);
+    dish->DishType::dietaryAccommodations(request);
+    countDish(totals_, dish, 1);
+    indexIngredients(dish);
+    updateBitmaps(dish, position, true);
+}
+
+/**
+ * @brief Creates a dietary variant of the menu that shares the base dishes.
+ *
+ * Unlike dietaryAdjustment(), no dish is modified and nothing is copied up
+ * front: each DietaryView materializes its accommodated dish on first access,
+ * so customers with different requests can be served from the same kitchen.
+ *
+ * @param request The dietary accommodations to apply.
+ * @return std::vector<DietaryView> One view per dish, in bag order.
+ */
+std::vector<DietaryView> Kitchen::dietaryVariant(const Dish::DietaryRequest& request) const {
+    std::vector<DietaryView> variant;
+    variant.reserve(getCurrentSize());
+    for (int i = 0; i < getCurrentSize(); i++) {
+        variant.emplace_back(items_[i], request);
+    }
+    return variant;
+}
+
+/**
+ * @return const LoadReport& The outcome of every line read by the CSV constructor.
+ */
+const LoadReport& Kitchen::getLoadReport() const {
+    return load_report_;
 }
 
 /**
@@ -226,30 +768,661 @@ void Kitchen::dietaryAdjustment(const Dish::DietaryRequest& request) {
  */
 void Kitchen::displayMenu() const {
     for (int i = 0; i < getCurrentSize(); i++) {
-        items_[i]->display();
+        displayDish(items_[i]);
         std::cout << "\n";  // Add blank line between dishes
     }
 }
 
 /**
- * @brief Splits a given string into a vector of substrings based on a specified delimiter.
+ * @brief Displays one dish through a call bound at compile time.
+ *
+ * The dish kind selects the subclass, whose display() is then called by
+ * its qualified name, so the call is direct and can be inlined.
+ *
+ * @param dish The dish to display.
+ */
+void Kitchen::displayDish(const Dish* dish) {
+    switch (dish->getKind()) {
+        case Dish::APPETIZER: static_cast<const Appetizer*>(dish)->Appetizer::display(); break;
+        case Dish::MAIN_COURSE: static_cast<const MainCourse*>(dish)->MainCourse::display(); break;
+        case Dish::DESSERT: static_cast<const Dessert*>(dish)->Dessert::display(); break;
+    }
+}
+
+/**
+ * @brief Streams the whole menu as one JSON object.
+ *
+ * @param out The stream to write to.
+ * @return bool True if every write succeeded.
+ */
+bool Kitchen::exportJson(std::ostream& out) const {
+    JsonWriter writer(out);
+    writer.beginObject();
+    writer.key("dish_count");
+    writer.integer(getCurrentSize());
+    writer.key("dishes");
+    writer.beginArray();
+    for (int i = 0; i < getCurrentSize(); i++) {
+        writeJson(writer, *items_[i]);
+    }
+    writer.endArray();
+    writer.endObject();
+    return writer.flush();
+}
+
+/**
+ * @brief Streams the whole menu as JSON to a file, or to standard output for "-".
+ *
+ * @param filename The path of the JSON file.
+ * @return bool True if the file was opened and every write succeeded.
+ */
+bool Kitchen::exportJson(const std::string& filename) const {
+    if (filename == "-") {
+        return exportJson(std::cout);
+    }
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error opening file: " << filename << std::endl;
+        return false;
+    }
+    return exportJson(file);
+}
+
+/**
+ * @brief Streams the whole menu to a columnar file.
+ *
+ * @param filename The path of the columnar file.
+ * @param chunk_rows The number of dishes per chunk.
+ * @return bool True if the file was opened and every write succeeded.
+ */
+bool Kitchen::exportColumnar(const std::string& filename, const int& chunk_rows) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error opening file: " << filename << std::endl;
+        return false;
+    }
+    ColumnarWriter writer(file, chunk_rows);
+    for (int i = 0; i < getCurrentSize(); i++) {
+        writer.append(*items_[i]);
+    }
+    return writer.finish();
+}
+
+/**
+ * @brief Writes every field of a dish, including its subclass fields, as a JSON object.
+ *
+ * @param writer The writer to append to.
+ * @param dish The dish to write.
+ */
+void Kitchen::writeJson(JsonWriter& writer, const Dish& dish) {
+    writer.beginObject();
+    writer.key("type");
+    writer.string(DISH_TYPE_NAMES[dish.getKind()]);
+    writer.key("name");
+    writer.string(dish.getName());
+    writer.key("ingredients");
+    writer.beginArray();
+    for (const auto& ingredient : dish.getIngredientList()) {
+        writer.string(ingredient);
+    }
+    writer.endArray();
+    writer.key("prep_time");
+    writer.integer(dish.getPrepTime());
+    writer.key("price");
+    writer.number(dish.getPrice());
+    writer.key("cuisine_type");
+    writer.string(dish.getCuisineType());
+
+    switch (dish.getKind()) {
+        case Dish::APPETIZER: {
+            const Appetizer& appetizer = static_cast<const Appetizer&>(dish);
+            writer.key("serving_style");
+            writer.string(SERVING_STYLE_NAMES[appetizer.getServingStyle()]);
+            writer.key("spiciness_level");
+            writer.integer(appetizer.getSpicinessLevel());
+            writer.key("vegetarian");
+            writer.boolean(appetizer.isVegetarian());
+            break;
+        }
+        case Dish::MAIN_COURSE: {
+            const MainCourse& main_course = static_cast<const MainCourse&>(dish);
+            writer.key("cooking_method");
+            writer.string(COOKING_METHOD_NAMES[main_course.getCookingMethod()]);
+            writer.key("protein_type");
+            writer.string(main_course.getProteinType());
+            writer.key("side_dishes");
+            writer.beginArray();
+            for (const auto& side : main_course.getSideDishes()) {
+                writer.beginObject();
+                writer.key("name");
+                writer.string(side.name);
+                writer.key("category");
+                writer.string(CATEGORY_NAMES[side.category]);
+                writer.endObject();
+            }
+            writer.endArray();
+            writer.key("gluten_free");
+            writer.boolean(main_course.isGlutenFree());
+            break;
+        }
+        case Dish::DESSERT: {
+            const Dessert& dessert = static_cast<const Dessert&>(dish);
+            writer.key("flavor_profile");
+            writer.string(FLAVOR_PROFILE_NAMES[dessert.getFlavorProfile()]);
+            writer.key("sweetness_level");
+            writer.integer(dessert.getSweetnessLevel());
+            writer.key("contains_nuts");
+            writer.boolean(dessert.containsNuts());
+            break;
+        }
+    }
+    writer.endObject();
+}
+
+/**
+ * @brief Displays the menu items in the given order.
+ *
+ * @param order The order to list the dishes in.
+ */
+void Kitchen::displayMenu(const MenuOrder& order) const {
+    for (Dish* dish : sortedView(order)) {
+        displayDish(dish);
+        std::cout << "\n";
+    }
+}
+
+/**
+ * @brief Returns the cached view for an order, building it if a mutation dropped it.
+ *
+ * Each dish's key is read once into a (key, bag index) pair, so the sort
+ * compares plain values instead of calling getters, and the bag index
+ * breaks ties. BY_NAME is copied from name_index_, which is already sorted,
+ * and BY_COURSE is a stable partition by dish kind, so neither needs a sort.
+ *
+ * @param order The sort order.
+ * @return const std::vector<Dish*>& Every dish, sorted.
+ */
+const std::vector<Dish*>& Kitchen::sortedView(const MenuOrder& order) const {
+    std::vector<Dish*>& view = sorted_views_[order];
+    if (sorted_views_valid_ & (1u << order)) {
+        return view;
+    }
+
+    view.clear();
+    view.reserve(getCurrentSize());
+    if (order == BY_NAME) {
+        for (const auto& entry : name_index_) {
+            view.push_back(entry.second);
+        }
+    } else if (order == BY_COURSE) {
+        for (int kind = Dish::APPETIZER; kind <= Dish::DESSERT; kind++) {
+            for (int i = 0; i < getCurrentSize(); i++) {
+                if (items_[i]->getKind() == kind) view.push_back(items_[i]);
+            }
+        }
+    } else if (order == BY_CUISINE_THEN_PRICE) {
+        std::vector<std::pair<std::pair<int, double>, int>> keys(getCurrentSize());
+        for (int i = 0; i < getCurrentSize(); i++) {
+            keys[i] = {{stringToCuisineType(items_[i]->getCuisineType()), priceSortKey(items_[i]->getPrice())}, i};
+        }
+        parallelSort(keys);
+        for (const auto& key : keys) view.push_back(items_[key.second]);
+    } else if (order == BY_PREP_TIME) {
+        std::vector<std::pair<int, int>> keys(getCurrentSize());
+        for (int i = 0; i < getCurrentSize(); i++) {
+            keys[i] = {items_[i]->getPrepTime(), i};
+        }
+        parallelSort(keys);
+        for (const auto& key : keys) view.push_back(items_[key.second]);
+    } else {
+        std::vector<std::pair<double, int>> keys(getCurrentSize());
+        for (int i = 0; i < getCurrentSize(); i++) {
+            keys[i] = {priceSortKey(items_[i]->getPrice()), i};
+        }
+        parallelSort(keys);
+        for (const auto& key : keys) view.push_back(items_[key.second]);
+    }
+    sorted_views_valid_ |= 1u << order;
+    return view;
+}
+
+/**
+ * @brief Marks every cached sorted view as stale. The vectors keep their storage for the rebuild.
+ */
+void Kitchen::invalidateSortedViews() {
+    sorted_views_valid_ = 0;
+}
+
+/**
+ * @brief Adds a dish to the ingredient, name and rank indexes.
+ *
+ * A dish given a non-finite price through setPrice() is left out of the price
+ * ranking, since NaN would break the ordering of the set.
+ *
+ * @param dish The dish that was just added to the bag.
+ */
+void Kitchen::indexDish(Dish* dish) {
+    indexIngredients(dish);
+    name_index_.emplace(dish->getName(), dish);
+    rank_index_[RANK_PREP_TIME].emplace(dish->getPrepTime(), dish);
+    if (std::isfinite(dish->getPrice())) {
+        rank_index_[RANK_PRICE].emplace(dish->getPrice(), dish);
+    }
+}
+
+/**
+ * @brief Removes a dish from the ingredient, name and rank indexes.
+ *
+ * @param dish The dish about to be removed from the bag.
+ */
+void Kitchen::unindexDish(const Dish* dish) {
+    unindexIngredients(dish);
+    unindexName(dish);
+    Dish* key_dish = const_cast<Dish*>(dish);  // Only compared, never written through.
+    rank_index_[RANK_PREP_TIME].erase({dish->getPrepTime(), key_dish});
+    if (std::isfinite(dish->getPrice())) {
+        rank_index_[RANK_PRICE].erase({dish->getPrice(), key_dish});
+    }
+}
+
+/**
+ * @brief Adds a dish to the posting list of each of its ingredients.
+ *
+ * The dish is appended, not inserted in order; the list is compacted once
+ * the appends outnumber its sorted part. A dish listing the same ingredient
+ * twice is only posted once. The ingredient count ranking is updated here
+ * too, since it changes whenever the ingredients do.
+ *
+ * @param dish The dish to index.
+ */
+void Kitchen::indexIngredients(Dish* dish) {
+    const Dish::IngredientList& ingredients = dish->getIngredientList();
+    for (size_t i = 0; i < ingredients.size(); i++) {
+        if (!isFirstOccurrence(ingredients, i)) continue;
+        PostingList& postings = ingredient_index_[ingredients[i]];
+        postings.dishes.push_back(dish);
+        if (postings.needsCompaction()) {
+            postings.compact();
+        }
+    }
+    rank_index_[RANK_INGREDIENT_COUNT].emplace(dish->getIngredientCount(), dish);
+}
+
+/**
+ * @brief Removes a dish from the posting lists of its ingredients.
+ *
+ * The dish is recorded as removed and subtracted at the next compaction;
+ * lists that compaction leaves empty are dropped from the index.
+ *
+ * @param dish The dish to remove, with the same ingredients it was indexed with.
+ */
+void Kitchen::unindexIngredients(const Dish* dish) {
+    const Dish::IngredientList& ingredients = dish->getIngredientList();
+    for (size_t i = 0; i < ingredients.size(); i++) {
+        if (!isFirstOccurrence(ingredients, i)) continue;
+        auto entry = ingredient_index_.find(ingredients[i]);
+        if (entry == ingredient_index_.end()) continue;
+        PostingList& postings = entry->second;
+        postings.removed.push_back(const_cast<Dish*>(dish));  // Only compared, never written through.
+        if (postings.needsCompaction()) {
+            postings.compact();
+            if (postings.dishes.empty()) {
+                ingredient_index_.erase(entry);
+            }
+        }
+    }
+    rank_index_[RANK_INGREDIENT_COUNT].erase({dish->getIngredientCount(), const_cast<Dish*>(dish)});
+}
+
+/**
+ * @brief Sorts the appended dishes into the list and subtracts the removed ones.
+ *
+ * Every live (dish, ingredient) pair has exactly one more entry in dishes than
+ * in removed, so a multiset difference leaves each live dish exactly once, even
+ * if a dish was unindexed and indexed again before the list was compacted.
+ */
+void Kitchen::PostingList::compact() {
+    std::less<const Dish*> order;
+    std::sort(dishes.begin() + sorted, dishes.end(), order);
+    std::inplace_merge(dishes.begin(), dishes.begin() + sorted, dishes.end(), order);
+    if (!removed.empty()) {
+        std::sort(removed.begin(), removed.end(), order);
+        std::vector<Dish*> kept;
+        kept.reserve(dishes.size());
+        std::set_difference(dishes.begin(), dishes.end(), removed.begin(), removed.end(),
+                            std::back_inserter(kept), order);
+        dishes.swap(kept);
+        removed.clear();
+    }
+    sorted = dishes.size();
+}
+
+/**
+ * @brief Checks whether enough mutations are pending to compact the list.
+ *
+ * @return True if the appended and removed dishes outnumber the sorted ones.
+ */
+bool Kitchen::PostingList::needsCompaction() const {
+    return dishes.size() - sorted + removed.size() > sorted;
+}
+
+/**
+ * @brief Returns the first k entries of a rank index.
+ *
+ * @param key The value to rank by.
+ * @param k The maximum number of dishes to return.
+ * @return std::vector<Dish*> Up to k dishes, highest key first.
+ */
+std::vector<Dish*> Kitchen::topDishes(const RankKey& key, const int& k) const {
+    std::vector<Dish*> top;
+    const auto& ranking = rank_index_[key];
+    for (auto entry = ranking.begin(); entry != ranking.end() && int(top.size()) < k; ++entry) {
+        top.push_back(entry->second);
+    }
+    return top;
+}
+
+/**
+ * @brief Sets or clears every filter index bit of a dish.
+ *
+ * The at most MAX_BITMAPS_PER_DISH bitmaps are gathered in a fixed array,
+ * so moving a dish between positions allocates nothing.
+ *
+ * @param dish The dish whose properties select the bitmaps.
+ * @param position The dish's position in the bag.
+ * @param present True to set the bits, false to clear them.
+ */
+void Kitchen::updateBitmaps(const Dish* dish, const int& position, const bool& present) {
+    Bitmap* bitmaps[MAX_BITMAPS_PER_DISH];
+    int count = 0;
+    switch (dish->getKind()) {
+        case Dish::APPETIZER:
+            bitmaps[count++] = &attribute_bitmaps_[IS_APPETIZER];
+            if (static_cast<const Appetizer*>(dish)->isVegetarian()) bitmaps[count++] = &attribute_bitmaps_[IS_VEGETARIAN];
+            break;
+        case Dish::MAIN_COURSE:
+            bitmaps[count++] = &attribute_bitmaps_[IS_MAIN_COURSE];
+            if (static_cast<const MainCourse*>(dish)->isGlutenFree()) bitmaps[count++] = &attribute_bitmaps_[IS_GLUTEN_FREE];
+            break;
+        case Dish::DESSERT:
+            bitmaps[count++] = &attribute_bitmaps_[IS_DESSERT];
+            if (static_cast<const Dessert*>(dish)->containsNuts()) bitmaps[count++] = &attribute_bitmaps_[CONTAINS_NUTS];
+            break;
+    }
+    bitmaps[count++] = &cuisine_bitmaps_[stringToCuisineType(dish->getCuisineType())];
+
+    double price = dish->getPrice() / PRICE_BUCKET_WIDTH;
+    bitmaps[count++] = &price_bitmaps_[!(price >= 0) ? 0 : price >= PRICE_BUCKETS - 1 ? PRICE_BUCKETS - 1 : int(price)];
+    int prep_time = dish->getPrepTime() / PREP_TIME_BUCKET_WIDTH;
+    bitmaps[count++] = &prep_time_bitmaps_[std::max(0, std::min(prep_time, PREP_TIME_BUCKETS - 1))];
+
+    for (int i = 0; i < count; i++) {
+        if (present) {
+            bitmaps[i]->set(position);
+        } else {
+            bitmaps[i]->reset(position);
+        }
+    }
+}
+
+const Bitmap& Kitchen::attributeBitmap(const DishAttribute& attribute) const {
+    return attribute_bitmaps_[attribute];
+}
+
+const Bitmap& Kitchen::cuisineBitmap(const Dish::CuisineType& cuisine_type) const {
+    return cuisine_bitmaps_[cuisine_type];
+}
+
+Bitmap Kitchen::priceRange(const double& low, const double& high) const {
+    return bucketRange(price_bitmaps_, PRICE_BUCKETS, PRICE_BUCKET_WIDTH, low, high, true);
+}
+
+Bitmap Kitchen::prepTimeRange(const int& low, const int& high) const {
+    return bucketRange(prep_time_bitmaps_, PREP_TIME_BUCKETS, PREP_TIME_BUCKET_WIDTH, low, high, false);
+}
+
+Bitmap Kitchen::allDishes() const {
+    return Bitmap::firstN(getCurrentSize());
+}
+
+/**
+ * @brief Unions the buckets inside [low, high] and filters the partly covered ones.
+ *
+ * Bucket b holds the values in [b * width, (b + 1) * width); the first
+ * bucket also holds negative values and the last one everything above.
+ *
+ * @param buckets The bucket bitmaps.
+ * @param bucket_count The number of buckets.
+ * @param width The width of a bucket.
+ * @param low The smallest value to include.
+ * @param high The largest value to include.
+ * @param by_price True to compare prices, false to compare preparation times.
+ * @return Bitmap The positions of the dishes in range.
+ */
+Bitmap Kitchen::bucketRange(const Bitmap* buckets, const int& bucket_count, const double& width,
+                            const double& low, const double& high, const bool& by_price) const {
+    Bitmap result;
+    for (int b = 0; b < bucket_count; b++) {
+        double bucket_low = b == 0 ? -HUGE_VAL : b * width;
+        double bucket_end = b == bucket_count - 1 ? HUGE_VAL : (b + 1) * width;
+        if (bucket_end <= low || bucket_low > high || buckets[b].empty()) {
+            continue;
+        }
+        if (low <= bucket_low && bucket_end <= high) {
+            result |= buckets[b];
+            continue;
+        }
+        for (int position : buckets[b].toVector()) {
+            double value = by_price ? items_[position]->getPrice() : items_[position]->getPrepTime();
+            if (low <= value && value <= high) {
+                result.set(position);
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * @param positions Bag positions from the filter index.
+ * @return std::vector<Dish*> The dishes at those positions.
+ */
+std::vector<Dish*> Kitchen::dishesIn(const Bitmap& positions) const {
+    std::vector<Dish*> dishes;
+    for (int position : positions.toVector()) {
+        if (position < getCurrentSize()) {
+            dishes.push_back(items_[position]);
+        }
+    }
+    return dishes;
+}
+
+/**
+ * @brief Returns every dish that lists the given ingredient.
+ *
+ * @param ingredient The exact ingredient name.
+ * @return std::vector<Dish*> The ingredient's posting list; empty if no dish uses the ingredient.
+ */
+std::vector<Dish*> Kitchen::dishesWithIngredient(const std::string& ingredient) const {
+    auto entry = ingredient_index_.find(ingredient);
+    if (entry == ingredient_index_.end()) {
+        return {};
+    }
+    entry->second.compact();
+    return entry->second.dishes;
+}
+
+/**
+ * @brief Answers an AND/OR/NOT ingredient query by merging sorted posting lists.
+ *
+ * The all_of lists are intersected shortest first, the result is intersected
+ * with the union of the any_of lists, and the union of the none_of lists is
+ * subtracted. Every step is a linear merge, so the cost is proportional to
+ * the lengths of the posting lists involved rather than the size of the kitchen.
+ *
+ * @param all_of Ingredients that must all be present.
+ * @param any_of Ingredients of which at least one must be present; ignored if empty.
+ * @param none_of Ingredients that must all be absent.
+ * @return std::vector<Dish*> The matching dishes, sorted by pointer value.
+ */
+std::vector<Dish*> Kitchen::ingredientQuery(const std::vector<std::string>& all_of,
+                                            const std::vector<std::string>& any_of,
+                                            const std::vector<std::string>& none_of) const {
+    static const std::vector<Dish*> empty_postings;
+    auto postingsOf = [this](const std::string& ingredient) -> const std::vector<Dish*>& {
+        auto entry = ingredient_index_.find(ingredient);
+        if (entry == ingredient_index_.end()) {
+            return empty_postings;
+        }
+        entry->second.compact();
+        return entry->second.dishes;
+    };
+    std::less<const Dish*> order;
+
+    std::vector<Dish*> result;
+    bool started = false;
+
+    if (!all_of.empty()) {
+        std::vector<const std::vector<Dish*>*> lists;
+        for (const auto& ingredient : all_of) {
+            lists.push_back(&postingsOf(ingredient));
+        }
+        std::sort(lists.begin(), lists.end(), [](const std::vector<Dish*>* a, const std::vector<Dish*>* b) {
+            return a->size() < b->size();
+        });
+        result = *lists[0];
+        for (size_t i = 1; i < lists.size() && !result.empty(); i++) {
+            std::vector<Dish*> narrowed;
+            std::set_intersection(result.begin(), result.end(), lists[i]->begin(), lists[i]->end(),
+                                  std::back_inserter(narrowed), order);
+            result.swap(narrowed);
+        }
+        started = true;
+    }
+
+    if (!any_of.empty()) {
+        std::vector<Dish*> either;
+        for (const auto& ingredient : any_of) {
+            const std::vector<Dish*>& postings = postingsOf(ingredient);
+            std::vector<Dish*> merged;
+            std::set_union(either.begin(), either.end(), postings.begin(), postings.end(),
+                           std::back_inserter(merged), order);
+            either.swap(merged);
+        }
+        if (started) {
+            std::vector<Dish*> narrowed;
+            std::set_intersection(result.begin(), result.end(), either.begin(), either.end(),
+                                  std::back_inserter(narrowed), order);
+            result.swap(narrowed);
+        } else {
+            result.swap(either);
+            started = true;
+        }
+    }
+
+    if (!started) {
+        result.assign(items_, items_ + getCurrentSize());
+        std::sort(result.begin(), result.end(), order);
+    }
+
+    for (const auto& ingredient : none_of) {
+        const std::vector<Dish*>& postings = postingsOf(ingredient);
+        std::vector<Dish*> kept;
+        std::set_difference(result.begin(), result.end(), postings.begin(), postings.end(),
+                            std::back_inserter(kept), order);
+        result.swap(kept);
+    }
+    return result;
+}
+
+/**
+ * @brief Removes a dish from the name index.
+ *
+ * @param dish The dish to remove; it must still have the name it was indexed with.
+ */
+void Kitchen::unindexName(const Dish* dish) {
+    auto range = name_index_.equal_range(dish->getName());
+    for (auto entry = range.first; entry != range.second; ++entry) {
+        if (entry->second == dish) {
+            name_index_.erase(entry);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Finds all dishes with exactly the given name.
+ *
+ * @param name The dish name to look up.
+ * @return std::vector<Dish*> The dishes with that name; empty if there are none.
+ */
+std::vector<Dish*> Kitchen::findDishesByName(const std::string& name) const {
+    std::vector<Dish*> matches;
+    auto range = name_index_.equal_range(name);
+    for (auto entry = range.first; entry != range.second; ++entry) {
+        matches.push_back(entry->second);
+    }
+    return matches;
+}
+
+/**
+ * @brief Finds all dishes whose name starts with the given prefix.
+ *
+ * Names sharing a prefix are adjacent in the index, so this is one binary
+ * search followed by a scan over the matches only.
+ *
+ * @param prefix The name prefix; an empty prefix matches every dish.
+ * @return std::vector<Dish*> The matching dishes, in name order.
+ */
+std::vector<Dish*> Kitchen::findDishesByPrefix(const std::string& prefix) const {
+    std::vector<Dish*> matches;
+    for (auto entry = name_index_.lower_bound(prefix);
+         entry != name_index_.end() && entry->first.compare(0, prefix.size(), prefix) == 0; ++entry) {
+        matches.push_back(entry->second);
+    }
+    return matches;
+}
+
+/**
+ * @brief Suggests dish names for autocompletion.
+ *
+ * @param prefix The text typed so far.
+ * @param limit The maximum number of suggestions.
+ * @return std::vector<std::string> Up to limit distinct names starting with prefix, alphabetically.
+ */
+std::vector<std::string> Kitchen::nameCompletions(const std::string& prefix, const int& limit) const {
+    std::vector<std::string> names;
+    for (auto entry = name_index_.lower_bound(prefix);
+         entry != name_index_.end() && int(names.size()) < limit &&
+         entry->first.compare(0, prefix.size(), prefix) == 0;
+         entry = name_index_.upper_bound(entry->first)) {
+        names.push_back(entry->first);
+    }
+    return names;
+}
+
+/**
+ * @brief Splits a given string into views of its fields based on a specified delimiter.
  * 
- * This function takes a string and a delimiter character, and splits the string into
- * substrings wherever the delimiter character is found. The substrings are stored in
- * a vector and returned.
+ * Matches splitting with std::getline: an empty string has no fields and a
+ * trailing delimiter does not start an empty last field. The views point into
+ * str, and fields is cleared first so its capacity is reused across calls.
  * 
  * @param str The string to be split.
  * @param delimiter The character used to split the string.
- * @return std::vector<std::string> A vector containing the substrings obtained by splitting the input string.
+ * @param fields Receives the fields of str, in order.
  */
-std::vector<std::string> Kitchen::split(const std::string& str, char delimiter) const {
-    std::vector<std::string> tokens;
-    std::stringstream ss(str);
-    std::string token;
-    while (std::getline(ss, token, delimiter)) {
-        tokens.push_back(token);
+void Kitchen::split(std::string_view str, char delimiter, std::vector<std::string_view>& fields) {
+    fields.clear();
+    size_t start = 0;
+    while (start < str.size()) {
+        size_t end = str.find(delimiter, start);
+        if (end == std::string_view::npos) {
+            fields.push_back(str.substr(start));
+            break;
+        }
+        fields.push_back(str.substr(start, end - start));
+        start = end + 1;
     }
-    return tokens;
 }
 
 /**
@@ -260,7 +1433,7 @@ std::vector<std::string> Kitchen::split(const std::string& str, char delimiter)
  * @return Dish::CuisineType The corresponding enum value of the cuisine type.
  *         Returns Dish::OTHER if the string does not match any known cuisine type.
  */
-Dish::CuisineType Kitchen::stringToCuisineType(const std::string& str) const {
+Dish::CuisineType Kitchen::stringToCuisineType(std::string_view str) {
     if (str == "ITALIAN") return Dish::ITALIAN;
     if (str == "MEXICAN") return Dish::MEXICAN;
     if (str == "CHINESE") return Dish::CHINESE;
@@ -285,7 +1458,7 @@ int Kitchen::getPrepTimeSum() const
     {
         return 0;
     }
-    return total_prep_time_;
+    return static_cast<int>(totals_.prep_time_sum);
 }
 
 /**
@@ -293,7 +1466,9 @@ int Kitchen::getPrepTimeSum() const
  * 
  * This function computes the average preparation time of all items currently
  * in the kitchen. If there are no items, it returns 0. The preparation time
- * is rounded to the nearest integer.
+ * is rounded to the nearest integer. It is read from the same running totals
+ * as kitchenReport(); after preparation times are changed in place,
+ * recomputeAggregates() refreshes them with a parallel reduction.
  * 
  * @return int The average preparation time of items, rounded to the nearest integer.
  */
@@ -301,12 +1476,7 @@ int Kitchen::calculateAvgPrepTime() const {
     if (getCurrentSize() == 0) {
         return 0;
     }
-    double total_prep_time_ = 0;
-    for (int i = 0; i < getCurrentSize(); i++) {
-        total_prep_time_ += items_[i]->getPrepTime();  // Using -> instead of .
-    }
-    total_prep_time_ = total_prep_time_ / getCurrentSize();
-    return round(total_prep_time_);
+    return round(double(totals_.prep_time_sum) / getCurrentSize());
 }
 
 /**
@@ -319,11 +1489,11 @@ int Kitchen::calculateAvgPrepTime() const {
  */
 int Kitchen::elaborateDishCount() const
 {
-    if (getCurrentSize() == 0 || count_elaborate_ == 0)
+    if (getCurrentSize() == 0 || totals_.elaborate_count == 0)
     {
         return 0;
     }
-    return count_elaborate_;
+    return totals_.elaborate_count;
 }
 
 /**
@@ -340,11 +1510,11 @@ int Kitchen::elaborateDishCount() const
 double Kitchen::calculateElaboratePercentage() const
 {
     // return percentage;
-    if (getCurrentSize() == 0 || count_elaborate_ == 0)
+    if (getCurrentSize() == 0 || totals_.elaborate_count == 0)
     {
         return 0;
     }
-    return round(double(count_elaborate_) / double(getCurrentSize()) * 10000)/100;
+    return round(double(totals_.elaborate_count) / double(getCurrentSize()) * 10000)/100;
 
     //return count_elaborate_ / getCurrentSize();
 }
@@ -352,20 +1522,18 @@ double Kitchen::calculateElaboratePercentage() const
 /**
  * @brief Tally the number of items of a specific cuisine type in the kitchen.
  * 
- * This function iterates through all items in the kitchen and counts how many
- * of them match the specified cuisine type.
+ * This function returns how many items in the kitchen match the specified
+ * cuisine type, from the running totals kitchenReport() prints.
  * 
  * @param cuisine_type The type of cuisine to tally.
  * @return int The number of items that match the specified cuisine type.
  */
 int Kitchen::tallyCuisineTypes(const std::string& cuisine_type) const {
-    int count = 0;
-    for (int i = 0; i < getCurrentSize(); i++) {
-        if (items_[i]->getCuisineType() == cuisine_type) {  // Using -> instead of .
-            count++;
-        }
+    Dish::CuisineType type = stringToCuisineType(cuisine_type);
+    if (type == Dish::OTHER && cuisine_type != "OTHER") {
+        return 0;  // No dish reports an unknown cuisine name.
     }
-    return count;
+    return totals_.cuisine_tally[type];
 }
 
 
@@ -433,20 +1601,182 @@ int Kitchen::releaseDishesOfCuisineType(const std::string& cuisine_type) {
  * - The average preparation time of all dishes.
  * - The percentage of elaborate dishes.
  * 
- * @note This function assumes the existence of the following member functions:
- * - tallyCuisineTypes(const std::string& cuisineType): Returns the count of dishes for the given cuisine type.
- * - calculateAvgPrepTime(): Returns the average preparation time of all dishes.
- * - calculateElaboratePercentage(): Returns the percentage of elaborate dishes.
+ * @note The figures come from reportSummary() and are printed by printReport(),
+ * which streamReport() callers and ShardedKitchen share.
  */
 void Kitchen::kitchenReport() const
 {
-    std::cout << "ITALIAN: " << tallyCuisineTypes("ITALIAN") << std::endl;
-    std::cout << "MEXICAN: " << tallyCuisineTypes("MEXICAN") << std::endl;
-    std::cout << "CHINESE: " << tallyCuisineTypes("CHINESE") << std::endl;
-    std::cout << "INDIAN: " << tallyCuisineTypes("INDIAN") << std::endl;
-    std::cout << "AMERICAN: " << tallyCuisineTypes("AMERICAN") << std::endl;
-    std::cout << "FRENCH: " << tallyCuisineTypes("FRENCH") << std::endl;
-    std::cout << "OTHER: " << tallyCuisineTypes("OTHER") << std::endl<<std::endl;
-    std::cout << "AVERAGE PREP TIME: " << calculateAvgPrepTime() << std::endl;
-    std::cout << "ELABORATE DISHES: " << calculateElaboratePercentage() << "%" << std::endl;
+    printReport(reportSummary());
+}
+
+/**
+ * @brief Collects the kitchen report figures.
+ *
+ * The figures are the running totals kept by newOrder(), serveDish() and
+ * dietaryAdjustment(), the same ones the aggregate accessors read, so a report
+ * costs O(1) and always agrees with them.
+ *
+ * @return ReportSummary The figures for the dishes currently in the kitchen.
+ */
+Kitchen::ReportSummary Kitchen::reportSummary() const
+{
+    return totals_;
+}
+
+/**
+ * @brief Recomputes every report figure from the dishes with a parallel reduction.
+ *
+ * Each chunk of dishes is summarised on its own and the chunk summaries are
+ * merged in order with mergeSummary(), so the price sum is rounded the same
+ * way on every run.
+ *
+ * @return ReportSummary The figures for the dishes currently in the kitchen.
+ */
+Kitchen::ReportSummary Kitchen::recomputeSummary() const
+{
+    return parallelReduce<ReportSummary>(getCurrentSize(), ReportSummary{},
+        [this](std::size_t first, std::size_t last) {
+            ReportSummary summary = {};
+            for (std::size_t i = first; i < last; i++) {
+                countDish(summary, items_[i], 1);
+            }
+            return summary;
+        },
+        mergeSummary);
+}
+
+/**
+ * @brief Replaces the running report totals with recomputed ones.
+ */
+void Kitchen::recomputeAggregates()
+{
+    totals_ = recomputeSummary();
+}
+
+/**
+ * @brief Adds the figures of one summary to another.
+ *
+ * @param total The summary to add to.
+ * @param part The summary to add.
+ */
+void Kitchen::mergeSummary(ReportSummary& total, const ReportSummary& part)
+{
+    for (int cuisine = 0; cuisine <= Dish::OTHER; cuisine++) {
+        total.cuisine_tally[cuisine] += part.cuisine_tally[cuisine];
+    }
+    total.dish_count += part.dish_count;
+    total.prep_time_sum += part.prep_time_sum;
+    total.price_sum += part.price_sum;
+    total.elaborate_count += part.elaborate_count;
+}
+
+/**
+ * @brief Prints report figures in the kitchenReport() format.
+ *
+ * The average preparation time is rounded to the nearest integer and the
+ * elaborate percentage to two decimal places, as in calculateAvgPrepTime()
+ * and calculateElaboratePercentage().
+ *
+ * @param summary The figures to print.
+ */
+void Kitchen::printReport(const ReportSummary& summary)
+{
+    int avg_prep_time = 0;
+    double elaborate_percentage = 0;
+    if (summary.dish_count != 0) {
+        avg_prep_time = round(double(summary.prep_time_sum) / summary.dish_count);
+        if (summary.elaborate_count != 0) {
+            elaborate_percentage = round(double(summary.elaborate_count) / double(summary.dish_count) * 10000)/100;
+        }
+    }
+    std::cout << "ITALIAN: " << summary.cuisine_tally[Dish::ITALIAN] << std::endl;
+    std::cout << "MEXICAN: " << summary.cuisine_tally[Dish::MEXICAN] << std::endl;
+    std::cout << "CHINESE: " << summary.cuisine_tally[Dish::CHINESE] << std::endl;
+    std::cout << "INDIAN: " << summary.cuisine_tally[Dish::INDIAN] << std::endl;
+    std::cout << "AMERICAN: " << summary.cuisine_tally[Dish::AMERICAN] << std::endl;
+    std::cout << "FRENCH: " << summary.cuisine_tally[Dish::FRENCH] << std::endl;
+    std::cout << "OTHER: " << summary.cuisine_tally[Dish::OTHER] << std::endl<<std::endl;
+    std::cout << "AVERAGE PREP TIME: " << avg_prep_time << std::endl;
+    std::cout << "ELABORATE DISHES: " << elaborate_percentage << "%" << std::endl;
+}
+
+/**
+ * @return Kitchen::StatSummary Count, mean, variance, min and max of the dish prices.
+ */
+Kitchen::StatSummary Kitchen::priceStats() const {
+    return statSummary(price_stats_, RANK_PRICE);
+}
+
+/**
+ * @return Kitchen::StatSummary Count, mean, variance, min and max of the preparation times.
+ */
+Kitchen::StatSummary Kitchen::prepTimeStats() const {
+    return statSummary(prep_time_stats_, RANK_PREP_TIME);
+}
+
+/**
+ * @brief Combines Welford moments with the extremes of the matching rank index.
+ *
+ * The rank index is ordered, so serving the current minimum or maximum
+ * needs no rescan: the next extreme is simply the new first or last entry.
+ *
+ * @param stats The running moments.
+ * @param key The rank index holding the same values.
+ * @return Kitchen::StatSummary The combined figures.
+ */
+Kitchen::StatSummary Kitchen::statSummary(const RunningStats& stats, const RankKey& key) const {
+    const auto& ranking = rank_index_[key];
+    StatSummary summary = {stats.getCount(), stats.getMean(), stats.getVariance(), 0, 0};
+    if (!ranking.empty()) {
+        summary.max = ranking.begin()->first;
+        summary.min = ranking.rbegin()->first;
+    }
+    return summary;
+}
+
+const QuantileSketch& Kitchen::priceSketch() const {
+    return price_sketch_;
+}
+
+const QuantileSketch& Kitchen::prepTimeSketch() const {
+    return prep_time_sketch_;
+}
+
+/**
+ * @brief Prints the kitchen report followed by price and preparation time statistics.
+ */
+void Kitchen::extendedReport() const
+{
+    kitchenReport();
+    std::cout << std::endl;
+    printStats("PRICE", priceStats());
+    printStats("PREP TIME", prepTimeStats());
+    printQuantiles("PRICE", price_sketch_);
+    printQuantiles("PREP TIME", prep_time_sketch_);
+}
+
+/**
+ * @brief Prints mean, standard deviation, min and max on one line.
+ *
+ * @param label The attribute name.
+ * @param stats The figures to print.
+ */
+void Kitchen::printStats(const std::string& label, const StatSummary& stats)
+{
+    std::cout << label << ": MEAN " << round(stats.mean * 100) / 100
+              << ", STD DEV " << round(std::sqrt(stats.variance) * 100) / 100
+              << ", MIN " << stats.min << ", MAX " << stats.max << std::endl;
+}
+
+/**
+ * @brief Prints the p50, p90 and p99 estimates of a sketch on one line.
+ *
+ * @param label The attribute name.
+ * @param sketch The sketch to query.
+ */
+void Kitchen::printQuantiles(const std::string& label, const QuantileSketch& sketch)
+{
+    std::cout << label << ": P50 " << round(sketch.quantile(0.5) * 100) / 100
+              << ", P90 " << round(sketch.quantile(0.9) * 100) / 100
+              << ", P99 " << round(sketch.quantile(0.99) * 100) / 100 << std::endl;
 }
@@ -6,16 +6,29 @@
 #define KITCHEN_HPP
 
 #include "ArrayBag.hpp"
+#include "Bitmap.hpp"
+#include "JsonWriter.hpp"
 #include "Dish.hpp"
 #include "Appetizer.hpp"
 #include "MainCourse.hpp"
 #include "Dessert.hpp"
+#include "DietaryView.hpp"
+#include "LoadReport.hpp"
+#include "QuantileSketch.hpp"
+#include "RunningStats.hpp"
 #include <cmath>
 #include <fstream>
+#include <functional>
+#include <map>
+#include <set>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
+class OrderLog;
+
 class Kitchen : public ArrayBag<Dish*> {
     public:
         /**
@@ -26,10 +39,16 @@ class Kitchen : public ArrayBag<Dish*> {
         /**
          * Parameterized constructor.
          * @param filename The name of the input CSV file containing dish information.
+         * @param expected_dishes Size hint for the bag. If negative (the default), the
+         *                        lines of the file are counted first so the bag is sized once.
+         * @param print_errors If true and some lines were rejected, the load report is
+         *                     printed to std::cerr once loading is done.
          * @pre The CSV file must be properly formatted.
          * @post Initializes the kitchen by reading dishes from the CSV file and storing them as Dish*.
+         *       The outcome of every line is available from getLoadReport(). A final line
+         *       without a newline is loaded too; loadAppendedDishes() resumes before it.
          */
-        Kitchen(const std::string& filename);
+        Kitchen(const std::string& filename, const int& expected_dishes = -1, const bool& print_errors = true);
 
         /**
          * Destructor.
@@ -38,6 +57,19 @@ class Kitchen : public ArrayBag<Dish*> {
         ~Kitchen();
 
         bool newOrder(Dish* new_dish);
+
+        /**
+         * Adds a batch of dishes. Room for the whole batch is reserved once and the
+         * preparation statistics are updated with a single sum over the batch.
+         * @param new_dishes The dishes to add. The kitchen takes ownership of each one added.
+         * @return One entry per dish: true if it was added, false if it was rejected (a null pointer).
+         */
+        std::vector<bool> newOrders(const std::vector<Dish*>& new_dishes);
+
+        /**
+         * Adds the dishes in the range [first, last); see newOrders(const std::vector<Dish*>&).
+         */
+        std::vector<bool> newOrders(Dish* const* first, Dish* const* last);
         bool serveDish(const Dish* dish_to_remove);
         int getPrepTimeSum() const;
         int calculateAvgPrepTime() const;
@@ -48,6 +80,126 @@ class Kitchen : public ArrayBag<Dish*> {
         int releaseDishesOfCuisineType(const std::string& cuisine_type);
         void kitchenReport() const;
 
+        /**
+         * Aggregate figures printed by kitchenReport().
+         */
+        struct ReportSummary {
+            int cuisine_tally[Dish::OTHER + 1]; ///< Dish count per CuisineType, indexed by enum value.
+            int dish_count;                     ///< Number of dishes counted.
+            long long prep_time_sum;            ///< Sum of all preparation times.
+            double price_sum;                   ///< Sum of all prices.
+            int elaborate_count;                ///< Dishes with 5+ ingredients and 60+ minutes prep time.
+        };
+
+        /**
+         * Computes the kitchenReport() figures straight from a menu CSV without building a Kitchen.
+         * Rows are parsed with the same rules as Kitchen(const std::string&), one at a time,
+         * so memory use does not grow with the size of the input and no Dish is ever allocated.
+         * @param input A stream positioned at the CSV header line.
+         * @param load_report If given, receives the outcome of every line. Otherwise, if
+         *                    lines were rejected, a report is printed to std::cerr at the end.
+         * @return The summary of every row the CSV constructor would have accepted.
+         */
+        static ReportSummary streamReport(std::istream& input, LoadReport* load_report = nullptr);
+
+        /**
+         * @param filename The path of the menu CSV, or "-" to read from standard input.
+         * @param load_report As for streamReport(std::istream&, LoadReport*).
+         * @return The summary of every row the CSV constructor would have accepted.
+         */
+        static ReportSummary streamReport(const std::string& filename, LoadReport* load_report = nullptr);
+
+        /**
+         * @return The figures kitchenReport() prints: the running totals that also back
+         *         getPrepTimeSum(), calculateAvgPrepTime(), elaborateDishCount(),
+         *         calculateElaboratePercentage() and tallyCuisineTypes().
+         */
+        ReportSummary reportSummary() const;
+
+        /**
+         * Recomputes every ReportSummary figure from the dishes themselves, for use after
+         * dishes were changed in place. Large kitchens are reduced in parallel over fixed
+         * chunks whose results are combined in order, so the figures, the floating-point
+         * price sum included, are identical from run to run and machine to machine.
+         * @return The figures for the dishes currently in the kitchen.
+         */
+        ReportSummary recomputeSummary() const;
+
+        /**
+         * Replaces the running totals behind reportSummary() and the aggregate
+         * accessors with recomputeSummary(), after dishes were changed in place.
+         */
+        void recomputeAggregates();
+
+        /**
+         * Adds the figures of part to total.
+         */
+        static void mergeSummary(ReportSummary& total, const ReportSummary& part);
+
+        /**
+         * Prints a summary in the same format as kitchenReport().
+         * @param summary The figures to print.
+         */
+        static void printReport(const ReportSummary& summary);
+
+        /**
+         * Distribution figures for one numeric dish attribute.
+         */
+        struct StatSummary {
+            int count;        ///< Number of dishes.
+            double mean;      ///< Mean value.
+            double variance;  ///< Population variance.
+            double min;       ///< Smallest value; 0 if there are no dishes.
+            double max;       ///< Largest value; 0 if there are no dishes.
+        };
+
+        /**
+         * @return Price statistics, maintained on every add and remove; no scan is made.
+         */
+        StatSummary priceStats() const;
+
+        /**
+         * @return Preparation time statistics, maintained on every add and remove; no scan is made.
+         */
+        StatSummary prepTimeStats() const;
+
+        /**
+         * @return A sketch of the dish prices, maintained on every add and remove.
+         *         Merge the sketches of several kitchens to get quantiles over all of them.
+         */
+        const QuantileSketch& priceSketch() const;
+
+        /**
+         * @return A sketch of the preparation times, maintained on every add and remove.
+         */
+        const QuantileSketch& prepTimeSketch() const;
+
+        /**
+         * Prints kitchenReport() followed by the price and preparation time statistics
+         * and their p50, p90 and p99.
+         */
+        void extendedReport() const;
+
+        /**
+         * Prints one line of statistics in the extendedReport() format.
+         * @param label The attribute name, e.g. "PRICE".
+         * @param stats The figures to print.
+         */
+        static void printStats(const std::string& label, const StatSummary& stats);
+
+        /**
+         * Prints the p50, p90 and p99 of a sketch on one line, in the extendedReport() format.
+         * @param label The attribute name, e.g. "PREP TIME".
+         * @param sketch The sketch to query.
+         */
+        static void printQuantiles(const std::string& label, const QuantileSketch& sketch);
+
+        /**
+         * Converts a cuisine name such as "ITALIAN" to its CuisineType.
+         * @return Dish::OTHER for unrecognised names.
+         */
+        static Dish::CuisineType stringToCuisineType(std::string_view str);
+
         /**
          * Adjusts all dishes in the kitchen based on the specified dietary accommodation.
          * @param request A DietaryRequest structure specifying the dietary accommodations.
@@ -55,25 +207,393 @@ class Kitchen : public ArrayBag<Dish*> {
          */
         void dietaryAdjustment(const Dish::DietaryRequest& request);
 
+        /**
+         * Builds a dietary variant of the menu without modifying any dish.
+         * @param request A DietaryRequest structure specifying the dietary accommodations.
+         * @return One DietaryView per dish, in bag order. Each view copies its dish only when
+         *         first accessed, and stays valid while the dish remains in the kitchen.
+         */
+        std::vector<DietaryView> dietaryVariant(const Dish::DietaryRequest& request) const;
+
         /**
          * Displays all dishes currently in the kitchen.
          * @post Calls the display() method of each dish.
          */
         void displayMenu() const;
 
+        /**
+         * Orders in which sortedView() and displayMenu(const MenuOrder&) list the dishes.
+         */
+        enum MenuOrder {
+            BY_PRICE,               ///< Ascending price.
+            BY_PREP_TIME,           ///< Ascending preparation time.
+            BY_NAME,                ///< Alphabetical by name.
+            BY_CUISINE_THEN_PRICE,  ///< By CuisineType enum value, then ascending price.
+            BY_COURSE,              ///< Appetizers, then main courses, then desserts.
+            MENU_ORDER_COUNT
+        };
+
+        /**
+         * Displays all dishes currently in the kitchen, sorted.
+         * @param order The order to list the dishes in.
+         */
+        void displayMenu(const MenuOrder& order) const;
+
+        /**
+         * Returns the dishes sorted by the given order. The view is built on first use
+         * with a parallel sort over precomputed keys and cached until the next newOrder,
+         * serveDish or dietaryAdjustment, which invalidates the returned reference.
+         * Dishes with equal keys keep bag order, except for BY_NAME, which is read
+         * from the name index and keeps insertion order. A NaN price sorts last.
+         * @param order The sort order.
+         * @return Every dish, sorted.
+         */
+        const std::vector<Dish*>& sortedView(const MenuOrder& order) const;
+
+        /**
+         * Writes every dish as JSON, {"dish_count": n, "dishes": [...]}, in bag order.
+         * The text is streamed through a JsonWriter, so no copy of the menu is built.
+         * @param out The stream to write to.
+         * @return True if every write succeeded.
+         */
+        bool exportJson(std::ostream& out) const;
+
+        /**
+         * @param filename The path of the JSON file to create, or "-" to write to standard output.
+         * @return True if the file was opened and every write succeeded.
+         */
+        bool exportJson(const std::string& filename) const;
+
+        /**
+         * Writes every dish in bag order to a columnar file (see ColumnarFile.hpp),
+         * streaming chunk_rows dishes at a time.
+         * @param filename The path of the file to create.
+         * @param chunk_rows The number of dishes per chunk.
+         * @return True if the file was opened and every write succeeded.
+         */
+        bool exportColumnar(const std::string& filename, const int& chunk_rows = 65536) const;
+
+        /**
+         * Writes one dish as a JSON object holding every Dish field and the fields of
+         * its subclass. "type" and the enums are spelled as in the menu CSV.
+         * @param writer The writer to append to.
+         * @param dish The dish to write.
+         */
+        static void writeJson(JsonWriter& writer, const Dish& dish);
+
+        /**
+         * @return The outcome of every line read by the CSV constructor; empty for other kitchens.
+         */
+        const LoadReport& getLoadReport() const;
+
+        /**
+         * Follow mode for an append-only menu CSV: parses only the lines added to the
+         * file since the CSV constructor (or the previous call) stopped reading, and
+         * inserts their dishes through newOrder().
+         * @return The number of dishes added, or -1 if there is no readable source file.
+         */
+        int loadAppendedDishes();
+
+        /**
+         * Starts (or, with nullptr, stops) recording mutations to a write-ahead log.
+         * @param order_log The log that receives every newOrder, serveDish and
+         *                  dietaryAdjustment. The kitchen does not take ownership.
+         */
+        void attachOrderLog(OrderLog* order_log);
+
+        /**
+         * @return The attached write-ahead log, or nullptr.
+         */
+        OrderLog* getOrderLog() const;
+
+        /**
+         * Looks up every dish that lists an ingredient.
+         * @param ingredient The exact ingredient name, e.g. "Peanuts".
+         * @return The matching dishes, in the index's (address) order.
+         */
+        std::vector<Dish*> dishesWithIngredient(const std::string& ingredient) const;
+
+        /**
+         * Boolean ingredient query answered from the ingredient index.
+         * @param all_of Every one of these ingredients must be present (AND).
+         * @param any_of If not empty, at least one of these must be present (OR).
+         * @param none_of None of these may be present (NOT).
+         * @return The matching dishes. If both all_of and any_of are empty, the query starts from every dish.
+         */
+        std::vector<Dish*> ingredientQuery(const std::vector<std::string>& all_of,
+                                           const std::vector<std::string>& any_of = {},
+                                           const std::vector<std::string>& none_of = {}) const;
+
+        /**
+         * @param name The exact dish name. Dishes whose name failed Dish::setName's
+         *             validation are stored under "UNKNOWN".
+         * @return Every dish with that name.
+         */
+        std::vector<Dish*> findDishesByName(const std::string& name) const;
+
+        /**
+         * @param prefix The start of a dish name (case-sensitive).
+         * @return Every dish whose name starts with prefix, in name order.
+         */
+        std::vector<Dish*> findDishesByPrefix(const std::string& prefix) const;
+
+        /**
+         * @param prefix The start of a dish name (case-sensitive).
+         * @param limit The maximum number of names to return.
+         * @return Up to limit distinct dish names starting with prefix, in alphabetical order.
+         */
+        std::vector<std::string> nameCompletions(const std::string& prefix, const int& limit) const;
+
+        /**
+         * Keys topDishes() can rank by.
+         */
+        enum RankKey { RANK_PREP_TIME, RANK_PRICE, RANK_INGREDIENT_COUNT, RANK_KEY_COUNT };
+
+        /**
+         * Reads the highest-ranked dishes from an index kept up to date by newOrder,
+         * serveDish and dietaryAdjustment, in O(k) without scanning the kitchen.
+         * @param key The value to rank by.
+         * @param k The maximum number of dishes to return.
+         * @return Up to k dishes, highest key first. Dishes with equal keys are in address order.
+         *         Dishes with a non-finite price are not ranked by price.
+         */
+        std::vector<Dish*> topDishes(const RankKey& key, const int& k) const;
+
+        /**
+         * Dish properties that have a bitmap in the filter index.
+         */
+        enum DishAttribute {
+            IS_APPETIZER,
+            IS_MAIN_COURSE,
+            IS_DESSERT,
+            IS_VEGETARIAN,   ///< Appetizers marked vegetarian.
+            IS_GLUTEN_FREE,  ///< Main courses marked gluten-free.
+            CONTAINS_NUTS,   ///< Desserts that contain nuts.
+            ATTRIBUTE_COUNT
+        };
+
+        static constexpr int PRICE_BUCKETS = 64;              ///< Price bitmaps; the last one is open-ended.
+        static constexpr double PRICE_BUCKET_WIDTH = 1.0;     ///< Dollars per price bitmap.
+        static constexpr int PREP_TIME_BUCKETS = 32;          ///< Prep time bitmaps; the last one is open-ended.
+        static constexpr int PREP_TIME_BUCKET_WIDTH = 10;     ///< Minutes per prep time bitmap.
+
+        /*
+         * Filter index. Each bitmap holds the bag positions of the dishes with
+         * one property, so filters combine with &, | and - instead of scanning,
+         * e.g. for Indian desserts up to $8 without nuts:
+         *     dishesIn((cuisineBitmap(Dish::INDIAN) & attributeBitmap(IS_DESSERT) & priceRange(0, 8))
+         *              - attributeBitmap(CONTAINS_NUTS))
+         * Positions change when a dish is served, so a bitmap is only meaningful
+         * until the next newOrder, serveDish or dietaryAdjustment.
+         */
+
+        /**
+         * @return The positions of the dishes with the given property.
+         */
+        const Bitmap& attributeBitmap(const DishAttribute& attribute) const;
+
+        /**
+         * @return The positions of the dishes of the given cuisine.
+         */
+        const Bitmap& cuisineBitmap(const Dish::CuisineType& cuisine_type) const;
+
+        /**
+         * @return The positions of the dishes priced from low to high, inclusive. Buckets inside
+         *         the range are used whole; only the two boundary buckets are checked dish by dish.
+         */
+        Bitmap priceRange(const double& low, const double& high) const;
+
+        /**
+         * @return The positions of the dishes whose preparation time is from low to high, inclusive.
+         */
+        Bitmap prepTimeRange(const int& low, const int& high) const;
+
+        /**
+         * @return The positions of every dish, for complementing a filter.
+         */
+        Bitmap allDishes() const;
+
+        /**
+         * @param positions A bitmap produced by the filter index since the last mutation.
+         * @return The dishes at those positions, in bag order.
+         */
+        std::vector<Dish*> dishesIn(const Bitmap& positions) const;
+
     private:
-        int total_prep_time_;
-        int count_elaborate_;
+        friend class OrderPipeline;
+
+        ReportSummary totals_;         ///< Running report figures for the dishes in the bag.
+        RunningStats price_stats_;
+        RunningStats prep_time_stats_;
+        QuantileSketch price_sketch_;
+        QuantileSketch prep_time_sketch_;
+        LoadReport load_report_;
+        std::string source_file_;      ///< CSV read by the constructor; empty if none.
+        std::streamoff source_offset_; ///< Byte offset just past the last line read from source_file_.
+        int source_line_;              ///< Number of lines of source_file_ read so far, header included.
+        std::string source_tail_;      ///< Unterminated last line the constructor loaded; empty if none.
+        OrderLog* order_log_;          ///< Write-ahead log of mutations, or nullptr.
+        mutable std::vector<Dish*> sorted_views_[MENU_ORDER_COUNT]; ///< sortedView() cache, one per order.
+        mutable unsigned sorted_views_valid_;                       ///< Bit i set if sorted_views_[i] is current.
+
+        /**
+         * The dishes that use one ingredient. Indexing appends to dishes and
+         * unindexing appends to removed, so neither shifts the list; compact()
+         * sorts the appended dishes in and subtracts removed, leaving dishes a
+         * set sorted by pointer value.
+         */
+        struct PostingList {
+            std::vector<Dish*> dishes;   ///< Sorted up to sorted, in insertion order after it.
+            std::vector<Dish*> removed;  ///< Dishes unindexed since the last compact().
+            size_t sorted = 0;           ///< Length of the sorted prefix of dishes.
+
+            /**
+             * Helper function to fold the appended and removed dishes into the sorted list
+             */
+            void compact();
+
+            /**
+             * @return True once the pending appends and removals outnumber the sorted
+             *         dishes, so compacting then costs O(log n) per mutation amortized.
+             */
+            bool needsCompaction() const;
+        };
+
+        /**
+         * Ingredient -> posting list of the dishes that use it. Queries compact
+         * the lists they read, so they can merge them with linear-time
+         * intersection, union and difference. Dishes must be re-indexed whenever
+         * the kitchen changes their ingredients.
+         */
+        mutable std::unordered_map<std::string, PostingList> ingredient_index_;
+
+        /**
+         * Dish name -> dish, ordered by name so exact and prefix lookups are
+         * binary searches. Keys are the names as returned by getName(), i.e.
+         * after Dish::setName has replaced invalid names with "UNKNOWN".
+         */
+        std::multimap<std::string, Dish*> name_index_;
+
+        /**
+         * Orders rank entries by descending key, then by dish address.
+         */
+        struct RankOrder {
+            bool operator()(const std::pair<double, Dish*>& a, const std::pair<double, Dish*>& b) const {
+                if (a.first != b.first) return a.first > b.first;
+                return std::less<const Dish*>()(a.second, b.second);
+            }
+        };
+
+        /**
+         * One ordered (key, dish) set per RankKey, highest key first, so insertions and
+         * removals, including removal of the current maximum, are O(log n).
+         */
+        std::set<std::pair<double, Dish*>, RankOrder> rank_index_[RANK_KEY_COUNT];
+
+        Bitmap attribute_bitmaps_[ATTRIBUTE_COUNT];     ///< Filter index by DishAttribute.
+        Bitmap cuisine_bitmaps_[Dish::OTHER + 1];       ///< Filter index by CuisineType.
+        Bitmap price_bitmaps_[PRICE_BUCKETS];           ///< Filter index by price bucket.
+        Bitmap prep_time_bitmaps_[PREP_TIME_BUCKETS];   ///< Filter index by prep time bucket.
+
+        /**
+         * Helper function to add a dish to every lookup index
+         */
+        void indexDish(Dish* dish);
+
+        /**
+         * Helper function to remove a dish from every lookup index
+         */
+        void unindexDish(const Dish* dish);
+
+        /**
+         * Helper function to add a dish to the posting list of each of its ingredients
+         */
+        void indexIngredients(Dish* dish);
+
+        /**
+         * Helper function to remove a dish from the posting lists of its ingredients
+         */
+        void unindexIngredients(const Dish* dish);
+
+        /**
+         * Helper function to remove a dish from the name index
+         */
+        void unindexName(const Dish* dish);
+
+        /**
+         * Helper function to drop every cached sortedView()
+         */
+        void invalidateSortedViews();
+
+        /**
+         * Helper function to display a dish through a statically bound call on its kind
+         */
+        static void displayDish(const Dish* dish);
+
+        /**
+         * Helper function to apply an accommodation to the dish at a position, known to be a DishType, and re-index it
+         */
+        template <class DishType>
+        void adjustDish(const int& position, const Dish::DietaryRequest& request);
+
+        /**
+         * Helper function to set (present) or clear the filter index bits of a dish at a bag position
+         */
+        void updateBitmaps(const Dish* dish, const int& position, const bool& present);
+
+        /**
+         * Helper function to answer a range query from bucket bitmaps
+         */
+        Bitmap bucketRange(const Bitmap* buckets, const int& bucket_count, const double& width,
+                           const double& low, const double& high, const bool& by_price) const;
+
+        /**
+         * Helper function to combine running moments with the extremes of a rank index
+         */
+        StatSummary statSummary(const RunningStats& stats, const RankKey& key) const;
+
+        /**
+         * One parsed line of the menu CSV, holding everything needed to build the dish.
+         */
+        struct DishRecord {
+            std::string dish_type;
+            std::string name;
+            std::vector<std::string> ingredients;
+            int prep_time;
+            double price;
+            Dish::CuisineType cuisine_type;
+            Appetizer::ServingStyle serving_style;
+            MainCourse::CookingMethod cooking_method;
+            Dessert::FlavorProfile flavor_profile;
+            std::string protein_type;
+            int level;   ///< Spiciness for appetizers, sweetness for desserts.
+            bool flag;   ///< Vegetarian, gluten-free or contains-nuts depending on dish_type.
+            std::vector<std::string_view> columns;     ///< Scratch space for parseRecord().
+            std::vector<std::string_view> attributes;  ///< Scratch space for parseRecord().
+        };
+
+        /**
+         * Helper function to count the lines after the CSV header
+         */
+        static int countLines(std::istream& input);
+
+        /**
+         * Helper function to parse one CSV line into a DishRecord. Never throws.
+         * @return LoadReport::RECORD_OK, or the reason the line was rejected.
+         */
+        static LoadReport::Status parseRecord(std::string_view line, DishRecord& record);
 
         /**
-         * Helper function to split a string by delimiter
+         * Helper function to allocate the Dish subclass described by a parsed record.
          */
-        std::vector<std::string> split(const std::string& str, char delimiter) const;
+        static Dish* makeDish(const DishRecord& record);
 
         /**
-         * Helper function to convert string to CuisineType
+         * Helper function to split a string by delimiter into views of str, with
+         * the same rules as std::getline: no field is produced after a trailing delimiter.
+         * @param fields Receives the fields; cleared first so its storage can be reused.
          */
-        Dish::CuisineType stringToCuisineType(const std::string& str) const;
+        static void split(std::string_view str, char delimiter, std::vector<std::string_view>& fields);
 };
 
 #endif // KITCHEN_HPP
@@ -0,0 +1,172 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#include "KitchenSimulator.hpp"
+#include "WorkStealingPool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <queue>
+
+/**
+ * @brief Groups the kitchen's dishes by station, keeping their bag positions.
+ *
+ * @param kitchen The kitchen to snapshot.
+ */
+KitchenSimulator::KitchenSimulator(const Kitchen& kitchen) : dish_count_(kitchen.getCurrentSize()) {
+    std::vector<Dish*> dishes = kitchen.toVector();
+    for (std::size_t i = 0; i < dishes.size(); i++) {
+        Station station = static_cast<Station>(dishes[i]->getKind());
+        positions_[station].push_back(i);
+        prep_times_[station].push_back(dishes[i]->getPrepTime());
+    }
+}
+
+/**
+ * @brief Simulates one scenario, station by station.
+ *
+ * @param scenario The scenario to simulate.
+ * @return ScenarioReport The figures for every station.
+ */
+KitchenSimulator::ScenarioReport KitchenSimulator::run(const Scenario& scenario) const {
+    ScenarioReport report;
+    report.name = scenario.name;
+    for (int station = 0; station < STATION_COUNT; station++) {
+        report.stations[station] = simulateStation(static_cast<Station>(station), scenario);
+    }
+    finishReport(report);
+    return report;
+}
+
+/**
+ * @brief Simulates the scenarios on a work-stealing pool.
+ *
+ * Each scenario task submits its stations as separate tasks, so a few large
+ * scenarios still spread over every worker.
+ *
+ * @param scenarios The scenarios to simulate.
+ * @param workers The number of worker threads.
+ * @return std::vector<ScenarioReport> The reports, in scenario order.
+ */
+std::vector<KitchenSimulator::ScenarioReport> KitchenSimulator::run(const std::vector<Scenario>& scenarios,
+                                                                    const int& workers) const {
+    std::vector<ScenarioReport> reports(scenarios.size());
+    {
+        WorkStealingPool pool(workers);
+        for (std::size_t i = 0; i < scenarios.size(); i++) {
+            pool.submit([this, &pool, &scenarios, &reports, i] {
+                reports[i].name = scenarios[i].name;
+                for (int station = 0; station < STATION_COUNT; station++) {
+                    pool.submit([this, &scenarios, &reports, i, station] {
+                        reports[i].stations[station] = simulateStation(static_cast<Station>(station), scenarios[i]);
+                    });
+                }
+            });
+        }
+        pool.wait();
+    }
+    for (auto& report : reports) {
+        finishReport(report);
+    }
+    return reports;
+}
+
+/**
+ * @brief Runs the station's tickets through its cooks in arrival order.
+ *
+ * The cooks are a min-heap of the times they next become free; each ticket
+ * starts when it arrives or when the earliest cook is free, whichever is later.
+ * Start times never decrease, so the tickets still waiting when a new one
+ * arrives are the tail of a FIFO of start times, which gives the queue length
+ * seen by every arrival. The FIFO only holds the tickets queued at that
+ * moment, so its size is the station's longest queue; with an arrival interval
+ * of 0 that is nearly every ticket of the station.
+ *
+ * @param station The station to simulate.
+ * @param scenario The scenario to simulate.
+ * @return StationReport The figures that do not need the scenario makespan.
+ */
+KitchenSimulator::StationReport KitchenSimulator::simulateStation(const Station& station, const Scenario& scenario) const {
+    StationReport report = {};
+    const std::vector<std::size_t>& positions = positions_[station];
+    const std::vector<int>& prep_times = prep_times_[station];
+    report.cooks = std::max(scenario.cooks[station], 0);
+    if (!positions.empty()) {
+        report.cooks = std::max(report.cooks, 1);
+    }
+    if (positions.empty() || scenario.rounds <= 0) {
+        return report;
+    }
+
+    std::priority_queue<double, std::vector<double>, std::greater<double>> free_at;
+    for (int cook = 0; cook < report.cooks; cook++) {
+        free_at.push(0.0);
+    }
+    std::deque<double> waiting;  // Start times of tickets that have arrived but not started.
+    for (int round = 0; round < scenario.rounds; round++) {
+        for (std::size_t i = 0; i < positions.size(); i++) {
+            double arrival = double(round * dish_count_ + positions[i]) * scenario.arrival_interval;
+            double start = std::max(arrival, free_at.top());
+            double done = start + prep_times[i];
+            free_at.pop();
+            free_at.push(done);
+
+            while (!waiting.empty() && waiting.front() <= arrival) {
+                waiting.pop_front();
+            }
+            if (start > arrival) {
+                waiting.push_back(start);
+            }
+            report.max_queue_length = std::max<long long>(report.max_queue_length, waiting.size());
+            report.total_wait += start - arrival;
+            report.busy_time += prep_times[i];
+            report.finish_time = std::max(report.finish_time, done);
+            report.tickets++;
+        }
+    }
+    return report;
+}
+
+/**
+ * @brief Sets the makespan and the figures measured against it.
+ *
+ * @param report The report whose stations have been simulated.
+ */
+void KitchenSimulator::finishReport(ScenarioReport& report) {
+    report.makespan = 0;
+    for (const StationReport& station : report.stations) {
+        report.makespan = std::max(report.makespan, station.finish_time);
+    }
+    for (StationReport& station : report.stations) {
+        if (report.makespan > 0 && station.cooks > 0) {
+            station.utilization = station.busy_time / (station.cooks * report.makespan);
+            station.average_queue_length = station.total_wait / report.makespan;
+        }
+        if (station.tickets > 0) {
+            station.average_wait = station.total_wait / station.tickets;
+        }
+    }
+}
+
+/**
+ * @brief Prints the makespan and one line per station.
+ *
+ * @param report The report to print.
+ * @param out The stream to print to.
+ */
+void KitchenSimulator::printReport(const ScenarioReport& report, std::ostream& out) {
+    static const char* const STATION_NAMES[STATION_COUNT] = {"APPETIZER", "MAIN COURSE", "DESSERT"};
+    out << "SCENARIO: " << report.name << std::endl;
+    out << "MAKESPAN: " << report.makespan << std::endl;
+    for (int station = 0; station < STATION_COUNT; station++) {
+        const StationReport& figures = report.stations[station];
+        out << STATION_NAMES[station] << ": " << figures.cooks << " cooks, "
+            << figures.tickets << " tickets, "
+            << round(figures.utilization * 10000) / 100 << "% utilization, "
+            << "average queue " << figures.average_queue_length << ", "
+            << "max queue " << figures.max_queue_length << ", "
+            << "average wait " << figures.average_wait << std::endl;
+    }
+}
@@ -0,0 +1,109 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#ifndef KITCHEN_SIMULATOR_HPP
+#define KITCHEN_SIMULATOR_HPP
+
+#include "Kitchen.hpp"
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @class KitchenSimulator
+ * @brief Discrete-event simulation of a kitchen's dishes going through cooking stations.
+ *
+ * Every dish is a ticket for the station of its kind (appetizer, main course or
+ * dessert), and its getPrepTime() is the time a cook spends on it. Tickets arrive
+ * in bag order, a fixed interval apart, for a given number of rounds over the
+ * menu. Each station serves its tickets first come, first served with its own
+ * number of cooks, and a ticket waits in the station's queue while every cook is
+ * busy. Times are in the units of getPrepTime(), i.e. minutes.
+ *
+ * Scenarios run in parallel on a WorkStealingPool: each scenario is one task,
+ * which submits one task per station for idle workers to steal.
+ */
+class KitchenSimulator {
+public:
+    /**
+     * Stations, indexed by Dish::DishKind.
+     */
+    enum Station { APPETIZER_STATION, MAIN_COURSE_STATION, DESSERT_STATION, STATION_COUNT };
+
+    /**
+     * One configuration to simulate.
+     */
+    struct Scenario {
+        std::string name;
+        int cooks[STATION_COUNT];   ///< Cooks per station; negative counts as 0, and a station with tickets gets at least one.
+        double arrival_interval;    ///< Time between consecutive tickets; 0 makes every ticket arrive at once.
+        int rounds;                 ///< Times the whole menu is ordered.
+    };
+
+    /**
+     * What happened at one station.
+     */
+    struct StationReport {
+        int cooks;                  ///< Cooks simulated.
+        long long tickets;          ///< Tickets served.
+        double busy_time;           ///< Total time cooks spent cooking.
+        double total_wait;          ///< Total time tickets spent queued.
+        double finish_time;         ///< When the last ticket was done.
+        long long max_queue_length; ///< Most tickets queued at once.
+        double utilization;         ///< busy_time / (cooks * makespan).
+        double average_queue_length;///< Time-averaged queue length over the makespan.
+        double average_wait;        ///< total_wait / tickets.
+    };
+
+    /**
+     * What happened in one scenario.
+     */
+    struct ScenarioReport {
+        std::string name;
+        double makespan;            ///< When the last ticket of any station was done.
+        StationReport stations[STATION_COUNT];
+    };
+
+    /**
+     * Takes a snapshot of the kitchen's dishes; later changes to the kitchen are not seen.
+     * @param kitchen The kitchen whose dishes become the tickets.
+     */
+    explicit KitchenSimulator(const Kitchen& kitchen);
+
+    /**
+     * Simulates one scenario on the calling thread.
+     */
+    ScenarioReport run(const Scenario& scenario) const;
+
+    /**
+     * Simulates every scenario in parallel.
+     * @param scenarios The scenarios to simulate.
+     * @param workers Worker threads; 0 uses one per hardware thread.
+     * @return One report per scenario, in the same order.
+     */
+    std::vector<ScenarioReport> run(const std::vector<Scenario>& scenarios, const int& workers = 0) const;
+
+    /**
+     * Prints a report in the kitchenReport() style.
+     */
+    static void printReport(const ScenarioReport& report, std::ostream& out);
+
+private:
+    std::size_t dish_count_;
+    std::vector<std::size_t> positions_[STATION_COUNT];  ///< Bag positions of the station's dishes.
+    std::vector<int> prep_times_[STATION_COUNT];         ///< Prep times of the station's dishes.
+
+    /**
+     * Helper function to simulate the tickets of one station
+     * @return The report, without the figures that need the scenario makespan.
+     */
+    StationReport simulateStation(const Station& station, const Scenario& scenario) const;
+
+    /**
+     * Helper function to fill in the figures that depend on the scenario makespan
+     */
+    static void finishReport(ScenarioReport& report);
+};
+
+#endif // KITCHEN_SIMULATOR_HPP
@@ -0,0 +1,102 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#include "LoadReport.hpp"
+#include <algorithm>
+
+/**
+ * Default constructor.
+ * Initializes all counts to zero.
+ */
+LoadReport::LoadReport() : lines_read_(0), counts_() {}
+
+/**
+ * @brief Records the outcome of one line, keeping its number if it is an early sample.
+ *
+ * @param line_number The 1-based line number in the file.
+ * @param status The outcome of parsing the line.
+ */
+void LoadReport::addLine(const int& line_number, const Status& status) {
+    lines_read_++;
+    counts_[status]++;
+    if (status != RECORD_OK && samples_[status].size() < MAX_SAMPLES) {
+        samples_[status].push_back(line_number);
+    }
+}
+
+int LoadReport::getLinesRead() const {
+    return lines_read_;
+}
+
+int LoadReport::getCount(const Status& status) const {
+    return counts_[status];
+}
+
+int LoadReport::getErrorCount() const {
+    return lines_read_ - counts_[RECORD_OK];
+}
+
+std::vector<int> LoadReport::getSampleLines(const Status& status) const {
+    return samples_[status];
+}
+
+/**
+ * @brief Adds another report's counts to this one.
+ *
+ * Samples are merged in line order and trimmed back to MAX_SAMPLES, which
+ * assumes both reports cover the same file.
+ *
+ * @param other The report to add.
+ */
+void LoadReport::merge(const LoadReport& other) {
+    lines_read_ += other.lines_read_;
+    for (int status = 0; status < STATUS_COUNT; status++) {
+        counts_[status] += other.counts_[status];
+        std::vector<int>& samples = samples_[status];
+        samples.insert(samples.end(), other.samples_[status].begin(), other.samples_[status].end());
+        std::sort(samples.begin(), samples.end());
+        if (samples.size() > MAX_SAMPLES) {
+            samples.resize(MAX_SAMPLES);
+        }
+    }
+}
+
+/**
+ * @brief Writes the report as a short block of text.
+ *
+ * @param out The stream to write to.
+ */
+void LoadReport::print(std::ostream& out) const {
+    out << "Lines read: " << lines_read_ << ", loaded: " << counts_[RECORD_OK]
+        << ", rejected: " << getErrorCount() << "\n";
+    for (int status = RECORD_OK + 1; status < STATUS_COUNT; status++) {
+        if (counts_[status] == 0) continue;
+        out << "  " << statusMessage(Status(status)) << ": " << counts_[status]
+            << (samples_[status].size() == 1 ? " (line" : " (lines");
+        for (int line : samples_[status]) {
+            out << " " << line;
+        }
+        if (counts_[status] > int(samples_[status].size())) {
+            out << " ...";
+        }
+        out << ")\n";
+    }
+    out.flush();
+}
+
+/**
+ * @param status An outcome.
+ * @return const char* A short, human-readable description.
+ */
+const char* LoadReport::statusMessage(const Status& status) {
+    switch (status) {
+        case RECORD_OK: return "ok";
+        case TOO_FEW_COLUMNS: return "too few columns";
+        case UNKNOWN_TYPE: return "unknown dish type";
+        case BAD_NUMBER: return "bad number";
+        case MISSING_ATTRIBUTE: return "missing attribute";
+        case STATUS_COUNT: break;
+    }
+    return "unknown error";
+}
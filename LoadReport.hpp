@@ -0,0 +1,93 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#ifndef LOAD_REPORT_HPP
+#define LOAD_REPORT_HPP
+
+#include <iostream>
+#include <vector>
+
+/**
+ * @class LoadReport
+ * @brief Counts the outcome of every line read from a menu CSV.
+ *
+ * Rejected lines are tallied per error class, and the line numbers of the
+ * first few lines of each class are kept as samples. Nothing is printed
+ * while loading; print() writes the whole summary at once.
+ */
+class LoadReport {
+public:
+    /**
+     * @enum Status
+     * @brief The outcome of parsing one CSV line.
+     */
+    enum Status {
+        RECORD_OK,          ///< The line was parsed into a dish.
+        TOO_FEW_COLUMNS,    ///< Fewer than 7 columns.
+        UNKNOWN_TYPE,       ///< dish_type is not APPETIZER, MAINCOURSE or DESSERT.
+        BAD_NUMBER,         ///< A numeric field is not a number or out of range.
+        MISSING_ATTRIBUTE,  ///< Fewer than 3 dish-specific attributes.
+        STATUS_COUNT
+    };
+
+    static const int MAX_SAMPLES = 5; ///< Line numbers kept per error class.
+
+    /**
+     * Default constructor.
+     * @post All counts are zero.
+     */
+    LoadReport();
+
+    /**
+     * Records the outcome of one line.
+     * @param line_number The 1-based line number in the file (the header is line 1).
+     * @param status The outcome of parsing the line.
+     */
+    void addLine(const int& line_number, const Status& status);
+
+    /**
+     * @return The number of data lines recorded.
+     */
+    int getLinesRead() const;
+
+    /**
+     * @param status An outcome.
+     * @return The number of lines with that outcome.
+     */
+    int getCount(const Status& status) const;
+
+    /**
+     * @return The number of lines that were rejected for any reason.
+     */
+    int getErrorCount() const;
+
+    /**
+     * @param status An error class.
+     * @return The line numbers of up to MAX_SAMPLES lines rejected for that reason, in file order.
+     */
+    std::vector<int> getSampleLines(const Status& status) const;
+
+    /**
+     * Adds the counts and samples of another report to this one.
+     */
+    void merge(const LoadReport& other);
+
+    /**
+     * Writes a summary: totals, then one line per error class that occurred with its sample line numbers.
+     * @param out The stream to write to.
+     */
+    void print(std::ostream& out) const;
+
+    /**
+     * @return A short description of an outcome, e.g. "bad number".
+     */
+    static const char* statusMessage(const Status& status);
+
+private:
+    int lines_read_;
+    int counts_[STATUS_COUNT];
+    std::vector<int> samples_[STATUS_COUNT];
+};
+
+#endif // LOAD_REPORT_HPP
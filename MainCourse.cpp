@@ -3,13 +3,14 @@
  * @author [Farhana Sultana]
  */
 #include "MainCourse.hpp"
+#include "AccommodationCache.hpp"
 
 /**
  * Default constructor.
  * Initializes all private members with default values.
  */
 MainCourse::MainCourse()
-    : Dish(), cooking_method_(GRILLED), protein_type_("UNKNOWN"), side_dishes_(), gluten_free_(false) {}
+    : Dish(MAIN_COURSE), cooking_method_(GRILLED), protein_type_("UNKNOWN"), side_dishes_(), gluten_free_(false) {}
 
 /**
  * Parameterized constructor.
@@ -24,7 +25,7 @@ MainCourse::MainCourse()
  * @param gluten_free Flag indicating if the main course is gluten-free.
  */
 MainCourse::MainCourse(const std::string& name, const std::vector<std::string>& ingredients, const int &prep_time, const double &price, const CuisineType &cuisine_type, const CookingMethod &cooking_method, const std::string& protein_type, const std::vector<SideDish>& side_dishes, const bool &gluten_free)
-    : Dish(name, ingredients, prep_time, price, cuisine_type), cooking_method_(cooking_method), protein_type_(protein_type), side_dishes_(side_dishes), gluten_free_(gluten_free) {}
+    : Dish(MAIN_COURSE, name, ingredients, prep_time, price, cuisine_type), cooking_method_(cooking_method), protein_type_(protein_type), side_dishes_(side_dishes), gluten_free_(gluten_free) {}
 
 /**
  * Sets the cooking method of the main course.
@@ -33,6 +34,7 @@ MainCourse::MainCourse(const std::string& name, const std::vector<std::string>&
  */
 void MainCourse::setCookingMethod(const CookingMethod &cooking_method) {
     cooking_method_ = cooking_method;
+    renewStateId();
 }
 
 /**
@@ -49,6 +51,7 @@ MainCourse::CookingMethod MainCourse::getCookingMethod() const {
  */
 void MainCourse::setProteinType(const std::string& protein_type) {
     protein_type_ = protein_type;
+    renewStateId();
 }
 
 /**
@@ -65,6 +68,7 @@ std::string MainCourse::getProteinType() const {
  */
 void MainCourse::addSideDish(const SideDish& side_dish) {
     side_dishes_.push_back(side_dish);
+    renewStateId();
 }
 
 /**
@@ -81,6 +85,7 @@ std::vector<MainCourse::SideDish> MainCourse::getSideDishes() const {
  */
 void MainCourse::setGlutenFree(const bool &gluten_free) {
     gluten_free_ = gluten_free;
+    renewStateId();
 }
 
 /**
@@ -91,6 +96,13 @@ bool MainCourse::isGlutenFree() const {
 }
 
 
+/**
+ * @return A new copy of this main course, owned by the caller.
+ */
+MainCourse* MainCourse::clone() const {
+    return new MainCourse(*this);
+}
+
 /**
 * Displays the main course's details.
 * @post Outputs the main course's details, including name, ingredients,
@@ -187,8 +199,32 @@ without substitution.
 involves gluten.
 * Gluten-containing side dish categories are: `GRAIN`,
 `PASTA`, `BREAD`, `STARCHES`.
+* Results are memoized in AccommodationCache by the dish and the request.
+Repeating the request on the unchanged result returns at once when it
+would change nothing, and the ingredients are only re-filtered after the
+dish has been changed since.
 */
 void MainCourse::dietaryAccommodations(const DietaryRequest& request) {
+    AccommodationCache::Result cached;
+    switch (AccommodationCache::find(this, request, cached)) {
+        case AccommodationCache::ALREADY_APPLIED:
+            return;
+        case AccommodationCache::CACHED_RESULT:
+            setIngredients(cached.ingredients);
+            gluten_free_ = cached.flag;
+            if (request.vegetarian || request.vegan) {
+                protein_type_ = "Tofu";
+            }
+            if (request.gluten_free) {
+                removeGlutenSideDishes();
+            }
+            restoreStateId(cached.output_state);
+            return;
+        case AccommodationCache::MISS:
+            break;
+    }
+    const unsigned long long input_state = getStateId();
+
     if (request.vegetarian) {
         protein_type_ = "Tofu";
         std::vector<std::string> non_vegetarian = {"Meat", "Chicken", "Fish", "Beef", "Pork", "Lamb", "Shrimp", "Bacon"};
@@ -240,15 +276,25 @@ void MainCourse::dietaryAccommodations(const DietaryRequest& request) {
     
     if (request.gluten_free) {
         gluten_free_ = true;
-        
-        // Remove side dishes with gluten-containing categories
-        std::vector<SideDish> new_side_dishes;
-        for (const auto& side : side_dishes_) {
-            if (side.category != GRAIN && side.category != PASTA && 
-                side.category != BREAD && side.category != STARCHES) {
-                new_side_dishes.push_back(side);
-            }
+        removeGlutenSideDishes();
+    }
+
+    renewStateId();
+    AccommodationCache::insert(request, {input_state, getStateId(), true, getIngredientList(), 0, gluten_free_});
+}
+
+/**
+ * @brief Removes side dishes with gluten-containing categories.
+ *
+ * Gluten-containing categories are GRAIN, PASTA, BREAD and STARCHES.
+ */
+void MainCourse::removeGlutenSideDishes() {
+    std::vector<SideDish> new_side_dishes;
+    for (const auto& side : side_dishes_) {
+        if (side.category != GRAIN && side.category != PASTA && 
+            side.category != BREAD && side.category != STARCHES) {
+            new_side_dishes.push_back(side);
         }
-        side_dishes_ = new_side_dishes;
     }
+    side_dishes_ = new_side_dishes;
 }
@@ -58,6 +58,11 @@ public:
 
     void display() const override;
     void dietaryAccommodations(const DietaryRequest& request) override;
+
+    /**
+     * @return A new copy of this main course, owned by the caller.
+     */
+    MainCourse* clone() const override;
     
     /**
      * Sets the cooking method of the main course.
@@ -112,6 +117,11 @@ private:
     std::string protein_type_; ///< The type of protein used in the main course.
     std::vector<SideDish> side_dishes_; ///< The side dishes served with the main course.
     bool gluten_free_; ///< Flag indicating if the main course is gluten-free.
+
+    /**
+     * Helper function to remove the side dishes whose category contains gluten
+     */
+    void removeGlutenSideDishes();
 };
 
 #endif // MAINCOURSE_HPP
@@ -0,0 +1,498 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#include "OrderLog.hpp"
+#include "AccommodationCache.hpp"
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+    enum DishKind : std::uint8_t { APPETIZER_KIND = 1, MAINCOURSE_KIND = 2, DESSERT_KIND = 3 };
+
+    std::uint32_t checksum(const char* data, std::size_t size) {
+        std::uint32_t hash = 2166136261u;
+        for (std::size_t i = 0; i < size; i++) {
+            hash = (hash ^ static_cast<unsigned char>(data[i])) * 16777619u;
+        }
+        return hash;
+    }
+
+    template <class T>
+    void put(std::string& out, const T& value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void putString(std::string& out, const std::string& value) {
+        put<std::uint32_t>(out, value.size());
+        out.append(value);
+    }
+
+    template <class T>
+    bool get(const char*& cursor, const char* end, T& value) {
+        if (end - cursor < static_cast<std::ptrdiff_t>(sizeof(T))) return false;
+        std::memcpy(&value, cursor, sizeof(T));
+        cursor += sizeof(T);
+        return true;
+    }
+
+    bool getString(const char*& cursor, const char* end, std::string& value) {
+        std::uint32_t size;
+        if (!get(cursor, end, size) || end - cursor < static_cast<std::ptrdiff_t>(size)) return false;
+        value.assign(cursor, size);
+        cursor += size;
+        return true;
+    }
+}
+
+/**
+ * @brief Opens the log file in append mode.
+ *
+ * @param filename The path of the log file.
+ * @param policy When records are forced to disk.
+ * @param group_commit_bytes Buffered bytes that trigger an automatic commit.
+ * @param max_commit_delay The longest a record stays buffered; zero starts no flusher thread.
+ */
+OrderLog::OrderLog(const std::string& filename, const SyncPolicy& policy, const std::size_t& group_commit_bytes,
+                   const std::chrono::milliseconds& max_commit_delay)
+    : filename_(filename), file_(nullptr), policy_(policy), group_commit_bytes_(group_commit_bytes),
+      file_bytes_(0), max_commit_delay_(max_commit_delay), stopping_(false) {
+    open("ab");
+    if (file_ == nullptr) {
+        std::cerr << "Error opening log: " << filename << std::endl;
+    }
+    if (max_commit_delay_.count() > 0 && policy_ != SYNC_EVERY_RECORD) {
+        flusher_ = std::thread(&OrderLog::flushLoop, this);
+    }
+}
+
+/**
+ * @brief Stops the flusher, commits buffered records and closes the file.
+ */
+OrderLog::~OrderLog() {
+    {
+        std::lock_guard<std::mutex> lock(log_mutex_);
+        stopping_ = true;
+    }
+    flush_wakeup_.notify_one();
+    if (flusher_.joinable()) {
+        flusher_.join();
+    }
+    if (file_ != nullptr) {
+        writeBuffer();
+        std::fclose(file_);
+    }
+}
+
+/**
+ * @brief Opens the log file and records how many bytes it already holds.
+ *
+ * @param mode The fopen mode, "ab" to append or "wb" to start empty.
+ */
+void OrderLog::open(const char* mode) {
+    file_ = std::fopen(filename_.c_str(), mode);
+    file_bytes_ = 0;
+    if (file_ != nullptr && std::fseek(file_, 0, SEEK_END) == 0) {
+        long end = std::ftell(file_);
+        file_bytes_ = end > 0 ? static_cast<std::size_t>(end) : 0;
+    }
+}
+
+bool OrderLog::isOpen() const {
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    return file_ != nullptr;
+}
+
+std::size_t OrderLog::getLogSize() const {
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    return file_bytes_ + buffer_.size();
+}
+
+const std::string& OrderLog::getFilename() const {
+    return filename_;
+}
+
+bool OrderLog::logNewOrder(const Dish& dish) {
+    std::string payload;
+    writeDish(payload, dish);
+    return append(NEW_ORDER, payload);
+}
+
+bool OrderLog::logServeDish(const Dish& dish) {
+    std::string payload;
+    writeDish(payload, dish);
+    return append(SERVE_DISH, payload);
+}
+
+bool OrderLog::logDietaryAdjustment(const Dish::DietaryRequest& request) {
+    std::string payload(1, static_cast<char>(AccommodationCache::requestMask(request)));
+    return append(DIETARY_ADJUSTMENT, payload);
+}
+
+bool OrderLog::logSnapshotBase(const std::string& segment) {
+    std::string payload;
+    put<std::uint64_t>(payload, segment.size());
+    put<std::uint32_t>(payload, checksum(segment.data(), segment.size()));
+    return append(SNAPSHOT_BASE, payload);
+}
+
+/**
+ * @brief Frames a payload and adds it to the group buffer.
+ *
+ * The flusher is woken when the buffer stops being empty, so it can time
+ * the oldest record.
+ *
+ * @param type The record type.
+ * @param payload The record body.
+ * @return bool False if a commit was due and failed.
+ */
+bool OrderLog::append(const RecordType& type, const std::string& payload) {
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    if (buffer_.empty()) {
+        oldest_buffered_ = std::chrono::steady_clock::now();
+        if (flusher_.joinable()) {
+            flush_wakeup_.notify_one();
+        }
+    }
+    put<std::uint8_t>(buffer_, type);
+    put<std::uint32_t>(buffer_, payload.size());
+    buffer_.append(payload);
+    put<std::uint32_t>(buffer_, checksum(payload.data(), payload.size()));
+    if (policy_ == SYNC_EVERY_RECORD || buffer_.size() >= group_commit_bytes_) {
+        return writeBuffer();
+    }
+    return true;
+}
+
+/**
+ * @brief Writes the buffered group of records in one call.
+ *
+ * @return bool True if the write (and sync, if the policy asks for it) succeeded.
+ */
+bool OrderLog::commit() {
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    return writeBuffer();
+}
+
+/**
+ * @brief Writes the buffer in one call and syncs it if the policy asks for it.
+ *
+ * If the write or flush fails, whatever part of the group reached the file
+ * is cut off again and the buffer and byte count are left as they were, so
+ * the next commit writes the whole group.
+ *
+ * @return bool True if every step succeeded.
+ */
+bool OrderLog::writeBuffer() {
+    if (file_ == nullptr) {
+        return false;
+    }
+    if (buffer_.empty()) {
+        return true;
+    }
+    if (std::fwrite(buffer_.data(), 1, buffer_.size(), file_) != buffer_.size() || std::fflush(file_) != 0) {
+        rollback();
+        return false;
+    }
+    file_bytes_ += buffer_.size();
+    buffer_.clear();
+    return policy_ == SYNC_NEVER || sync();
+}
+
+/**
+ * @brief Reopens the log with only the bytes committed before the failed write.
+ *
+ * Closing the stream discards what stdio still holds of the group; the file
+ * is then truncated to file_bytes_ and reopened for appending.
+ */
+void OrderLog::rollback() {
+    const std::size_t committed = file_bytes_;
+    std::fclose(file_);
+    std::error_code error;
+    std::filesystem::resize_file(filename_, committed, error);
+    open("ab");
+}
+
+/**
+ * @brief Commits the buffer once its oldest record is max_commit_delay_ old.
+ *
+ * Sleeps until a record is buffered, then until that record's deadline.
+ * A commit by another caller in the meantime empties the buffer and the
+ * wait starts over.
+ */
+void OrderLog::flushLoop() {
+    std::unique_lock<std::mutex> lock(log_mutex_);
+    while (!stopping_) {
+        if (buffer_.empty()) {
+            flush_wakeup_.wait(lock);
+            continue;
+        }
+        const auto deadline = oldest_buffered_ + max_commit_delay_;
+        if (flush_wakeup_.wait_until(lock, deadline) == std::cv_status::timeout && !buffer_.empty() &&
+            std::chrono::steady_clock::now() >= oldest_buffered_ + max_commit_delay_ && !writeBuffer()) {
+            oldest_buffered_ = std::chrono::steady_clock::now();  // Retry after another delay.
+        }
+    }
+}
+
+/**
+ * @brief Empties the log file and the group buffer.
+ *
+ * @return bool True if the file was reopened empty.
+ */
+bool OrderLog::truncate() {
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    buffer_.clear();
+    if (file_ != nullptr) {
+        std::fclose(file_);
+    }
+    open("wb");
+    if (file_ == nullptr) {
+        return false;
+    }
+    return policy_ == SYNC_NEVER || sync();
+}
+
+/**
+ * @brief Seals the current log file under a new name and starts an empty one.
+ *
+ * Only the buffered group is written while the lock is held, so a writer
+ * waits for at most one group commit plus a rename.
+ *
+ * @param sealed_filename The name the current log file is moved to.
+ * @return bool True if the log was rotated.
+ */
+bool OrderLog::rotate(const std::string& sealed_filename) {
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    if (file_ == nullptr) {
+        return false;
+    }
+    // The sealed segment must be durable before it is renamed, even if
+    // nothing is buffered: earlier writes may not have been synced.
+    SyncPolicy policy = policy_;
+    policy_ = SYNC_NEVER;
+    bool written = writeBuffer() && sync();
+    policy_ = policy;
+    std::fclose(file_);
+    file_ = nullptr;
+    bool renamed = written && std::rename(filename_.c_str(), sealed_filename.c_str()) == 0;
+    open(renamed ? "wb" : "ab");
+    return renamed && file_ != nullptr;
+}
+
+/**
+ * @brief Forces written data to stable storage.
+ *
+ * @return bool True on success.
+ */
+bool OrderLog::sync() {
+#ifdef _WIN32
+    return _commit(_fileno(file_)) == 0;
+#else
+    return fsync(fileno(file_)) == 0;
+#endif
+}
+
+/**
+ * @brief Serializes every field of a dish, including its subclass fields.
+ *
+ * @param out The buffer to append to.
+ * @param dish The dish to serialize.
+ */
+void OrderLog::writeDish(std::string& out, const Dish& dish) {
+    Dish::DishKind kind = dish.getKind();
+    const Appetizer* appetizer = kind == Dish::APPETIZER ? static_cast<const Appetizer*>(&dish) : nullptr;
+    const MainCourse* main_course = kind == Dish::MAIN_COURSE ? static_cast<const MainCourse*>(&dish) : nullptr;
+    const Dessert* dessert = kind == Dish::DESSERT ? static_cast<const Dessert*>(&dish) : nullptr;
+    put<std::uint8_t>(out, appetizer ? APPETIZER_KIND : main_course ? MAINCOURSE_KIND : DESSERT_KIND);
+
+    putString(out, dish.getName());
+    std::vector<std::string> ingredients = dish.getIngredients();
+    put<std::uint32_t>(out, ingredients.size());
+    for (const auto& ingredient : ingredients) {
+        putString(out, ingredient);
+    }
+    put<std::int32_t>(out, dish.getPrepTime());
+    put<double>(out, dish.getPrice());
+    put<std::uint8_t>(out, Kitchen::stringToCuisineType(dish.getCuisineType()));
+
+    if (appetizer != nullptr) {
+        put<std::uint8_t>(out, appetizer->getServingStyle());
+        put<std::int32_t>(out, appetizer->getSpicinessLevel());
+        put<std::uint8_t>(out, appetizer->isVegetarian());
+    } else if (main_course != nullptr) {
+        put<std::uint8_t>(out, main_course->getCookingMethod());
+        putString(out, main_course->getProteinType());
+        std::vector<MainCourse::SideDish> sides = main_course->getSideDishes();
+        put<std::uint32_t>(out, sides.size());
+        for (const auto& side : sides) {
+            putString(out, side.name);
+            put<std::uint8_t>(out, side.category);
+        }
+        put<std::uint8_t>(out, main_course->isGlutenFree());
+    } else if (dessert != nullptr) {
+        put<std::uint8_t>(out, dessert->getFlavorProfile());
+        put<std::int32_t>(out, dessert->getSweetnessLevel());
+        put<std::uint8_t>(out, dessert->containsNuts());
+    }
+}
+
+/**
+ * @brief Rebuilds a dish serialized by writeDish().
+ *
+ * @param cursor Start of the serialized dish; advanced past it on success.
+ * @param end End of the readable bytes.
+ * @return Dish* A new dish, or nullptr if the bytes are malformed.
+ */
+Dish* OrderLog::readDish(const char*& cursor, const char* end) {
+    std::uint8_t kind, cuisine;
+    std::string name;
+    std::uint32_t ingredient_count;
+    if (!get(cursor, end, kind) || !getString(cursor, end, name) || !get(cursor, end, ingredient_count)) {
+        return nullptr;
+    }
+    std::vector<std::string> ingredients(ingredient_count);
+    for (auto& ingredient : ingredients) {
+        if (!getString(cursor, end, ingredient)) return nullptr;
+    }
+    std::int32_t prep_time;
+    double price;
+    if (!get(cursor, end, prep_time) || !get(cursor, end, price) || !get(cursor, end, cuisine)) {
+        return nullptr;
+    }
+    Dish::CuisineType cuisine_type = static_cast<Dish::CuisineType>(cuisine);
+
+    std::uint8_t style, flag;
+    std::int32_t level;
+    if (kind == APPETIZER_KIND) {
+        if (!get(cursor, end, style) || !get(cursor, end, level) || !get(cursor, end, flag)) return nullptr;
+        return new Appetizer(name, ingredients, prep_time, price, cuisine_type,
+                             static_cast<Appetizer::ServingStyle>(style), level, flag != 0);
+    }
+    if (kind == MAINCOURSE_KIND) {
+        std::string protein;
+        std::uint32_t side_count;
+        if (!get(cursor, end, style) || !getString(cursor, end, protein) || !get(cursor, end, side_count)) {
+            return nullptr;
+        }
+        std::vector<MainCourse::SideDish> sides(side_count);
+        for (auto& side : sides) {
+            std::uint8_t category;
+            if (!getString(cursor, end, side.name) || !get(cursor, end, category)) return nullptr;
+            side.category = static_cast<MainCourse::Category>(category);
+        }
+        if (!get(cursor, end, flag)) return nullptr;
+        return new MainCourse(name, ingredients, prep_time, price, cuisine_type,
+                              static_cast<MainCourse::CookingMethod>(style), protein, sides, flag != 0);
+    }
+    if (kind == DESSERT_KIND) {
+        if (!get(cursor, end, style) || !get(cursor, end, level) || !get(cursor, end, flag)) return nullptr;
+        return new Dessert(name, ingredients, prep_time, price, cuisine_type,
+                           static_cast<Dessert::FlavorProfile>(style), level, flag != 0);
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Replays a log file into a kitchen.
+ *
+ * The whole file is read into memory and decoded in one pass.
+ *
+ * @param filename The path of the log file.
+ * @param kitchen The kitchen to apply the records to.
+ * @return int The number of records applied, or -1 if the file cannot be opened.
+ */
+int OrderLog::replay(const std::string& filename, Kitchen& kitchen) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return -1;
+    }
+    std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return replay(contents.data(), contents.data() + contents.size(), kitchen);
+}
+
+/**
+ * @brief Replays log bytes held in memory into a kitchen.
+ *
+ * Replay stops at the first record that is truncated, fails its checksum
+ * or cannot be decoded. SNAPSHOT_BASE records are skipped.
+ *
+ * @param first Start of the log bytes.
+ * @param last End of the log bytes.
+ * @param kitchen The kitchen to apply the records to.
+ * @return int The number of records applied.
+ */
+int OrderLog::replay(const char* first, const char* last, Kitchen& kitchen) {
+    OrderLog* attached = kitchen.getOrderLog();
+    kitchen.attachOrderLog(nullptr);
+
+    int applied = 0;
+    const char* cursor = first;
+    const char* end = last;
+    while (cursor < end) {
+        std::uint8_t type = 0;
+        std::uint32_t size = 0, stored_checksum = 0;
+        if (!get(cursor, end, type) || !get(cursor, end, size) ||
+            end - cursor < static_cast<std::ptrdiff_t>(size) + 4) {
+            break;
+        }
+        const char* payload = cursor;
+        cursor += size;
+        if (!get(cursor, end, stored_checksum) || checksum(payload, size) != stored_checksum) {
+            break;
+        }
+
+        const char* payload_end = payload + size;
+        if (type == NEW_ORDER || type == SERVE_DISH) {
+            Dish* dish = readDish(payload, payload_end);
+            if (dish == nullptr) break;
+            if (type == NEW_ORDER) {
+                if (!kitchen.newOrder(dish)) delete dish;
+            } else {
+                kitchen.serveDish(dish);
+                delete dish;
+            }
+        } else if (type == DIETARY_ADJUSTMENT && size == 1) {
+            unsigned mask = static_cast<unsigned char>(*payload);
+            Dish::DietaryRequest request = {(mask & 1u) != 0, (mask & 2u) != 0, (mask & 4u) != 0,
+                                            (mask & 8u) != 0, (mask & 16u) != 0, (mask & 32u) != 0};
+            kitchen.dietaryAdjustment(request);
+        } else if (type == SNAPSHOT_BASE) {
+            continue;
+        } else {
+            break;
+        }
+        applied++;
+    }
+
+    kitchen.attachOrderLog(attached);
+    return applied;
+}
+
+/**
+ * @brief Checks whether a snapshot already contains a sealed log segment.
+ *
+ * @param snapshot The contents of a snapshot file.
+ * @param segment The contents of a sealed log segment.
+ * @return bool True if the snapshot's SNAPSHOT_BASE record matches the segment's size and checksum.
+ */
+bool OrderLog::absorbs(const std::string& snapshot, const std::string& segment) {
+    const char* cursor = snapshot.data();
+    const char* end = cursor + snapshot.size();
+    std::uint8_t type;
+    std::uint32_t size, segment_checksum;
+    std::uint64_t segment_size;
+    return get(cursor, end, type) && type == SNAPSHOT_BASE && get(cursor, end, size) &&
+           size == sizeof(segment_size) + sizeof(segment_checksum) && get(cursor, end, segment_size) &&
+           get(cursor, end, segment_checksum) && segment_size == segment.size() &&
+           segment_checksum == checksum(segment.data(), segment.size());
+}
@@ -0,0 +1,218 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#ifndef ORDER_LOG_HPP
+#define ORDER_LOG_HPP
+
+#include "Kitchen.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @class OrderLog
+ * @brief Append-only binary write-ahead log of Kitchen mutations.
+ *
+ * A Kitchen with an attached log records every successful newOrder(),
+ * every serveDish() that removed a dish, and every dietaryAdjustment().
+ * Replaying the log on top of the same base CSV rebuilds the kitchen.
+ *
+ * Records are buffered and written in groups: commit() writes the buffer,
+ * and it is also written automatically once it holds group_commit_bytes or
+ * its oldest record has waited max_commit_delay, so a quiet period does not
+ * leave logged records in memory. The SyncPolicy decides when the file is
+ * flushed to stable storage. A group that cannot be written is cut back off
+ * the file and stays buffered, to be written again by the next commit.
+ *
+ * Record layout, in host byte order:
+ *   u8 type | u32 payload length | payload | u32 FNV-1a checksum of the payload
+ * NEW_ORDER and SERVE_DISH payloads hold a serialized dish; DIETARY_ADJUSTMENT
+ * holds the request as a one-byte mask (AccommodationCache::requestMask).
+ * Replay stops at the first truncated or corrupt record, so a torn write at
+ * the end of the file only loses the records that were never committed.
+ *
+ * A log may be written by the kitchen's thread while another thread calls
+ * commit(), rotate() or getLogSize(); every operation holds the log's mutex.
+ */
+class OrderLog {
+public:
+    /**
+     * @enum SyncPolicy
+     * @brief When written records are forced to disk.
+     */
+    enum SyncPolicy {
+        SYNC_NEVER,        ///< Leave flushing to the operating system.
+        SYNC_ON_COMMIT,    ///< fsync after every group of records is written.
+        SYNC_EVERY_RECORD  ///< Write and fsync each record as it is logged.
+    };
+
+    /**
+     * @enum RecordType
+     * @brief The mutation a record describes.
+     */
+    enum RecordType { NEW_ORDER = 1, SERVE_DISH = 2, DIETARY_ADJUSTMENT = 3, SNAPSHOT_BASE = 4 };
+
+    /**
+     * Opens (or creates) a log file for appending.
+     * @param filename The path of the log file.
+     * @param policy When records are forced to disk.
+     * @param group_commit_bytes Buffered bytes that trigger an automatic commit.
+     * @param max_commit_delay The longest a record stays buffered before a background
+     *                         thread commits it; zero leaves it to commit() and the size limit.
+     */
+    OrderLog(const std::string& filename, const SyncPolicy& policy = SYNC_ON_COMMIT,
+             const std::size_t& group_commit_bytes = 1 << 16,
+             const std::chrono::milliseconds& max_commit_delay = std::chrono::milliseconds(100));
+
+    /**
+     * Commits any buffered records and closes the file.
+     */
+    ~OrderLog();
+
+    OrderLog(const OrderLog&) = delete;
+    OrderLog& operator=(const OrderLog&) = delete;
+
+    /**
+     * @return True if the log file could be opened.
+     */
+    bool isOpen() const;
+
+    /**
+     * The log* functions buffer one record, writing the group if it is due.
+     * @return False if a write was due and failed; the record stays buffered.
+     */
+    bool logNewOrder(const Dish& dish);
+    bool logServeDish(const Dish& dish);
+    bool logDietaryAdjustment(const Dish::DietaryRequest& request);
+
+    /**
+     * Records which sealed log segment a snapshot already contains.
+     * Replay skips this record; absorbs() reads it back.
+     * @param segment The full contents of the segment folded into the snapshot.
+     * @return As for logNewOrder().
+     */
+    bool logSnapshotBase(const std::string& segment);
+
+    /**
+     * Writes all buffered records and syncs them according to the policy.
+     * @return True if every write succeeded. If the write failed the records stay
+     *         buffered; if only the sync failed they are in the file but may not be durable.
+     */
+    bool commit();
+
+    /**
+     * Discards every record, committed or buffered, leaving an empty log.
+     * @return True if the file was truncated.
+     */
+    bool truncate();
+
+    /**
+     * Commits the buffered records, renames the log file and starts a new,
+     * empty one under the original name. The pause is bounded by one group commit.
+     * @param sealed_filename The name the current log file is moved to.
+     * @return True if the file was renamed and a new log opened.
+     */
+    bool rotate(const std::string& sealed_filename);
+
+    /**
+     * @return The size of the log file plus the records still buffered, in bytes.
+     */
+    std::size_t getLogSize() const;
+
+    /**
+     * @return The path of the log file.
+     */
+    const std::string& getFilename() const;
+
+    /**
+     * Applies the records of a log file to a kitchen, in order.
+     * The kitchen's attached log, if any, is detached while replaying.
+     * @param filename The path of the log file.
+     * @param kitchen The kitchen to apply the records to.
+     * @return The number of records applied, or -1 if the file cannot be opened.
+     */
+    static int replay(const std::string& filename, Kitchen& kitchen);
+
+    /**
+     * Applies the records held in memory to a kitchen, in order.
+     * @param first Start of the log bytes.
+     * @param last End of the log bytes.
+     * @param kitchen The kitchen to apply the records to.
+     * @return The number of records applied.
+     */
+    static int replay(const char* first, const char* last, Kitchen& kitchen);
+
+    /**
+     * @param snapshot The contents of a snapshot file.
+     * @param segment The contents of a sealed log segment.
+     * @return True if the snapshot begins with a SNAPSHOT_BASE record naming this segment.
+     */
+    static bool absorbs(const std::string& snapshot, const std::string& segment);
+
+    /**
+     * Appends the serialized form of a dish to a byte buffer.
+     */
+    static void writeDish(std::string& out, const Dish& dish);
+
+    /**
+     * Reads a dish written by writeDish().
+     * @param cursor Start of the serialized dish; advanced past it on success.
+     * @param end End of the readable bytes.
+     * @return A new dish owned by the caller, or nullptr if the bytes are malformed.
+     */
+    static Dish* readDish(const char*& cursor, const char* end);
+
+private:
+    std::string filename_;
+    std::FILE* file_;
+    SyncPolicy policy_;
+    std::size_t group_commit_bytes_;
+    std::string buffer_;
+    std::size_t file_bytes_;          ///< Bytes already written to the log file.
+    std::chrono::milliseconds max_commit_delay_;
+    std::chrono::steady_clock::time_point oldest_buffered_;  ///< When the buffer last became non-empty.
+    bool stopping_;
+    mutable std::mutex log_mutex_;
+    std::condition_variable flush_wakeup_;
+    std::thread flusher_;
+
+    /**
+     * Frames a payload as a record and buffers it, committing if needed.
+     * @return False if a commit was due and failed.
+     */
+    bool append(const RecordType& type, const std::string& payload);
+
+    /**
+     * Helper function to write the buffer and sync it per the policy.
+     * @pre log_mutex_ is held.
+     */
+    bool writeBuffer();
+
+    /**
+     * Helper function to open the log file and record its current size.
+     */
+    void open(const char* mode);
+
+    /**
+     * Helper function to cut the file back to file_bytes_ after a failed write
+     * @pre log_mutex_ is held.
+     */
+    void rollback();
+
+    /**
+     * Commits the buffer whenever its oldest record has waited max_commit_delay_.
+     */
+    void flushLoop();
+
+    /**
+     * Forces written data to stable storage.
+     */
+    bool sync();
+};
+
+#endif // ORDER_LOG_HPP
@@ -0,0 +1,142 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#include "OrderPipeline.hpp"
+
+/**
+ * @brief Builds the pipeline and, if workers > 0, starts its threads.
+ *
+ * @param kitchen The kitchen that receives the dishes.
+ * @param request The dietary accommodation applied to every dish.
+ * @param workers Worker threads for each of the parse and accommodate stages.
+ * @param channel_capacity The capacity of each channel between stages.
+ */
+OrderPipeline::OrderPipeline(Kitchen& kitchen, const Dish::DietaryRequest& request,
+                             const int& workers, const std::size_t& channel_capacity)
+    : kitchen_(kitchen), request_(request), lines_(channel_capacity), parsed_(channel_capacity),
+      accommodated_(channel_capacity), finished_(false),
+      submitted_(0), parse_errors_(0), invalid_names_(0), inserted_(0) {
+    for (int i = 0; i < workers; i++) {
+        parse_workers_.emplace_back(&OrderPipeline::parseLoop, this);
+        accommodate_workers_.emplace_back(&OrderPipeline::accommodateLoop, this);
+    }
+    if (workers > 0) {
+        inserter_ = std::thread(&OrderPipeline::insertLoop, this);
+    }
+}
+
+/**
+ * @brief Drains and stops the pipeline if the caller did not call finish().
+ */
+OrderPipeline::~OrderPipeline() {
+    finish();
+}
+
+/**
+ * @brief Submits one CSV line.
+ *
+ * Processes the line immediately when the pipeline has no workers; otherwise
+ * queues it, blocking while the first channel is full. Only lines that are
+ * processed or queued are counted as submitted.
+ *
+ * @param line The CSV line describing one dish.
+ * @return bool False if the pipeline has already been finished.
+ */
+bool OrderPipeline::submit(const std::string& line) {
+    if (finished_) {
+        return false;
+    }
+    if (!inserter_.joinable()) {
+        submitted_++;
+        Dish* dish = parse(line);
+        if (dish != nullptr) {
+            dish->dietaryAccommodations(request_);
+            insert(dish);
+        }
+        return true;
+    }
+    // Counted under the channel's lock, so finish(), which closes the channel
+    // first, never returns before a line it accepted has been counted.
+    return lines_.push(line, [this] { submitted_++; });
+}
+
+/**
+ * @brief Closes each stage in turn and waits for its workers to drain it.
+ *
+ * @return Result The counts for all submitted lines.
+ */
+OrderPipeline::Result OrderPipeline::finish() {
+    if (!finished_.exchange(true)) {
+        lines_.close();
+        for (auto& worker : parse_workers_) {
+            worker.join();
+        }
+        parsed_.close();
+        for (auto& worker : accommodate_workers_) {
+            worker.join();
+        }
+        accommodated_.close();
+        if (inserter_.joinable()) {
+            inserter_.join();
+        }
+    }
+    return Result{submitted_, parse_errors_, invalid_names_, inserted_};
+}
+
+/**
+ * @brief Parses a line with the Kitchen CSV rules and allocates its dish.
+ *
+ * @param line The CSV line.
+ * @return Dish* The new dish, or nullptr if the line is malformed or its name is invalid.
+ */
+Dish* OrderPipeline::parse(const std::string& line) {
+    Kitchen::DishRecord record;
+    if (Kitchen::parseRecord(line, record) != LoadReport::RECORD_OK) {
+        parse_errors_++;
+        return nullptr;
+    }
+    if (!Dish::isValidName(record.name)) {
+        invalid_names_++;
+        return nullptr;
+    }
+    return Kitchen::makeDish(record);
+}
+
+/**
+ * @brief Adds a dish to the kitchen.
+ *
+ * @param dish The dish to add; freed if the kitchen does not accept it.
+ */
+void OrderPipeline::insert(Dish* dish) {
+    if (kitchen_.newOrder(dish)) {
+        inserted_++;
+    } else {
+        delete dish;
+    }
+}
+
+void OrderPipeline::parseLoop() {
+    std::string line;
+    while (lines_.pop(line)) {
+        Dish* dish = parse(line);
+        if (dish != nullptr) {
+            parsed_.push(dish);
+        }
+    }
+}
+
+void OrderPipeline::accommodateLoop() {
+    Dish* dish = nullptr;
+    while (parsed_.pop(dish)) {
+        dish->dietaryAccommodations(request_);
+        accommodated_.push(dish);
+    }
+}
+
+void OrderPipeline::insertLoop() {
+    Dish* dish = nullptr;
+    while (accommodated_.pop(dish)) {
+        insert(dish);
+    }
+}
@@ -0,0 +1,107 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#ifndef ORDER_PIPELINE_HPP
+#define ORDER_PIPELINE_HPP
+
+#include "BoundedChannel.hpp"
+#include "Kitchen.hpp"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class OrderPipeline
+ * @brief Feeds CSV order lines into a Kitchen through overlapping stages.
+ *
+ * Stages: parse the line (same rules as the Kitchen CSV constructor) and
+ * reject names that fail Dish::isValidName, apply dietaryAccommodations(),
+ * then insert through Kitchen::newOrder(). Stages are connected by
+ * BoundedChannels, so a slow stage makes submit() block instead of letting
+ * queued work grow without limit.
+ *
+ * With zero workers every line is processed synchronously inside submit()
+ * on the caller's thread. Otherwise each of the first two stages runs on its
+ * own pool of worker threads and a single thread performs the insertions, so
+ * the Kitchen is only ever modified by one thread. With more than one worker
+ * dishes may be inserted in a different order than they were submitted.
+ */
+class OrderPipeline {
+public:
+    /**
+     * Counts of what happened to the submitted lines.
+     */
+    struct Result {
+        int submitted;        ///< Lines accepted by submit(), i.e. for which it returned true.
+        int parse_errors;     ///< Lines skipped because they could not be parsed.
+        int invalid_names;    ///< Lines rejected by Dish::isValidName.
+        int inserted;         ///< Dishes added to the kitchen.
+    };
+
+    /**
+     * @param kitchen The kitchen that receives the dishes. It must not be modified
+     *                by anyone else until finish() returns.
+     * @param request The dietary accommodation applied to every dish.
+     * @param workers Worker threads per parallel stage; 0 processes lines inline.
+     * @param channel_capacity The maximum number of items queued between two stages.
+     */
+    OrderPipeline(Kitchen& kitchen, const Dish::DietaryRequest& request,
+                  const int& workers = 0, const std::size_t& channel_capacity = 1024);
+
+    /**
+     * Finishes the pipeline if finish() has not been called.
+     */
+    ~OrderPipeline();
+
+    OrderPipeline(const OrderPipeline&) = delete;
+    OrderPipeline& operator=(const OrderPipeline&) = delete;
+
+    /**
+     * Submits one CSV line (without the header). Blocks while the pipeline is full.
+     * @param line The CSV line describing one dish.
+     * @return False if the pipeline has already been finished.
+     */
+    bool submit(const std::string& line);
+
+    /**
+     * Closes the input, waits for every submitted line to be processed and
+     * stops the workers.
+     * @return The counts for all submitted lines.
+     */
+    Result finish();
+
+private:
+    Kitchen& kitchen_;
+    Dish::DietaryRequest request_;
+    BoundedChannel<std::string> lines_;
+    BoundedChannel<Dish*> parsed_;
+    BoundedChannel<Dish*> accommodated_;
+    std::vector<std::thread> parse_workers_;
+    std::vector<std::thread> accommodate_workers_;
+    std::thread inserter_;
+    std::atomic<bool> finished_;
+
+    std::atomic<int> submitted_;
+    std::atomic<int> parse_errors_;
+    std::atomic<int> invalid_names_;
+    std::atomic<int> inserted_;
+
+    /**
+     * Parses a line and allocates its dish.
+     * @return The new dish, or nullptr if the line was rejected.
+     */
+    Dish* parse(const std::string& line);
+
+    /**
+     * Adds a dish to the kitchen, freeing it if the kitchen refuses it.
+     */
+    void insert(Dish* dish);
+
+    void parseLoop();
+    void accommodateLoop();
+    void insertLoop();
+};
+
+#endif // ORDER_PIPELINE_HPP
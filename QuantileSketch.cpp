@@ -0,0 +1,146 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#include "QuantileSketch.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/**
+ * @brief Creates an empty sketch.
+ *
+ * @param relative_accuracy The relative error bound of every quantile estimate.
+ */
+QuantileSketch::QuantileSketch(const double& relative_accuracy)
+    : relative_accuracy_(relative_accuracy),
+      gamma_((1 + relative_accuracy) / (1 - relative_accuracy)),
+      log_gamma_(std::log(gamma_)),
+      count_(0),
+      zero_count_(0),
+      non_finite_count_(0) {}
+
+/**
+ * @brief Maps a finite value of at least MIN_POSITIVE to its bucket.
+ *
+ * The index is clamped to the range of int, so a tiny relative accuracy
+ * cannot make the conversion overflow.
+ *
+ * @param value The value.
+ * @return int The bucket index.
+ */
+int QuantileSketch::bucketOf(const double& value) const {
+    double index = std::ceil(std::log(value) / log_gamma_);
+    if (index >= static_cast<double>(std::numeric_limits<int>::max())) {
+        return std::numeric_limits<int>::max();
+    }
+    if (index <= static_cast<double>(std::numeric_limits<int>::min())) {
+        return std::numeric_limits<int>::min();
+    }
+    return static_cast<int>(index);
+}
+
+/**
+ * @brief Counts a value. NaN and infinities are only counted by getNonFiniteCount().
+ *
+ * @param value The value to count.
+ */
+void QuantileSketch::add(const double& value) {
+    if (!std::isfinite(value)) {
+        non_finite_count_++;
+        return;
+    }
+    count_++;
+    if (value < MIN_POSITIVE) {
+        zero_count_++;
+    } else {
+        buckets_[bucketOf(value)]++;
+    }
+}
+
+/**
+ * @brief Uncounts a value, the same way add() counted it.
+ *
+ * @param value The value to uncount.
+ */
+void QuantileSketch::remove(const double& value) {
+    if (!std::isfinite(value)) {
+        if (non_finite_count_ > 0) non_finite_count_--;
+        return;
+    }
+    if (value < MIN_POSITIVE) {
+        if (zero_count_ == 0) return;
+        zero_count_--;
+    } else {
+        auto bucket = buckets_.find(bucketOf(value));
+        if (bucket == buckets_.end()) return;
+        if (--bucket->second == 0) {
+            buckets_.erase(bucket);
+        }
+    }
+    count_--;
+}
+
+/**
+ * @brief Adds the bucket counts of another sketch to this one.
+ *
+ * @param other A sketch with the same relative accuracy.
+ */
+void QuantileSketch::merge(const QuantileSketch& other) {
+    for (const auto& bucket : other.buckets_) {
+        buckets_[bucket.first] += bucket.second;
+    }
+    zero_count_ += other.zero_count_;
+    count_ += other.count_;
+    non_finite_count_ += other.non_finite_count_;
+}
+
+long long QuantileSketch::getCount() const {
+    return count_;
+}
+
+long long QuantileSketch::getNonFiniteCount() const {
+    return non_finite_count_;
+}
+
+double QuantileSketch::getRelativeAccuracy() const {
+    return relative_accuracy_;
+}
+
+/**
+ * @brief Finds the bucket holding the value at rank floor(q * (count - 1)).
+ *
+ * The estimate is the point of the bucket (gamma^(i-1), gamma^i] whose
+ * relative distance to both ends is the relative accuracy.
+ *
+ * @param q The quantile, clamped to [0, 1].
+ * @return double The estimated value.
+ */
+double QuantileSketch::quantile(const double& q) const {
+    if (count_ == 0) {
+        return 0;
+    }
+    double clamped = q < 0 ? 0 : (q > 1 ? 1 : q);
+    long long rank = static_cast<long long>(clamped * (count_ - 1));
+    long long seen = zero_count_;
+    if (rank < seen) {
+        return 0;
+    }
+    for (const auto& bucket : buckets_) {
+        seen += bucket.second;
+        if (rank < seen) {
+            return estimate(bucket.first);
+        }
+    }
+    return estimate(buckets_.rbegin()->first);
+}
+
+/**
+ * @brief Returns the representative value of a bucket, at most the largest finite double.
+ *
+ * @param bucket The bucket index.
+ * @return double The estimate for every value in the bucket.
+ */
+double QuantileSketch::estimate(const int& bucket) const {
+    return std::min(2 * std::pow(gamma_, bucket) / (gamma_ + 1), std::numeric_limits<double>::max());
+}
@@ -0,0 +1,96 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#ifndef QUANTILE_SKETCH_HPP
+#define QUANTILE_SKETCH_HPP
+
+#include <map>
+
+/**
+ * @class QuantileSketch
+ * @brief Approximate quantiles of non-negative values, with deletions and merging.
+ *
+ * Values are counted in logarithmically sized buckets (the DDSketch scheme):
+ * bucket i holds the values in (gamma^(i-1), gamma^i], where
+ * gamma = (1 + a) / (1 - a) for relative accuracy a. Values below
+ * MIN_POSITIVE, including zero and negatives, share one zero bucket.
+ * NaN and infinities are not sketched; they are only counted by
+ * getNonFiniteCount().
+ *
+ * Error bound: quantile(q) is within a relative error of a of the value
+ * ranked floor(q * (count - 1)) among the values counted; values in the
+ * zero bucket are reported as 0. The bound holds after any sequence of
+ * add(), remove() and merge(), because every operation is an exact
+ * update of bucket counts.
+ *
+ * The number of buckets grows only with the logarithm of the value range,
+ * not with the number of values: about ln(max / min) / (2a) buckets, or
+ * a few hundred for prices and preparation times at a = 1%. A query walks
+ * the buckets once, so its cost is independent of the kitchen size.
+ */
+class QuantileSketch {
+public:
+    static constexpr double MIN_POSITIVE = 1e-9; ///< Smaller values are counted as zero.
+
+    /**
+     * @param relative_accuracy The relative error bound a, between 0 and 1 (exclusive).
+     */
+    explicit QuantileSketch(const double& relative_accuracy = 0.01);
+
+    /**
+     * Counts one value. NaN and infinities are counted apart and do not affect quantiles.
+     */
+    void add(const double& value);
+
+    /**
+     * Uncounts one value that was previously added.
+     * @pre value was added and not yet removed.
+     */
+    void remove(const double& value);
+
+    /**
+     * Adds every value counted by other.
+     * @pre other has the same relative accuracy.
+     */
+    void merge(const QuantileSketch& other);
+
+    /**
+     * @return The number of finite values counted.
+     */
+    long long getCount() const;
+
+    /**
+     * @return The number of NaN and infinite values passed to add() and not removed.
+     */
+    long long getNonFiniteCount() const;
+
+    double getRelativeAccuracy() const;
+
+    /**
+     * @param q The quantile, from 0 (minimum) to 1 (maximum), e.g. 0.99 for p99.
+     * @return The estimated value at that quantile, or 0 if the sketch is empty.
+     */
+    double quantile(const double& q) const;
+
+private:
+    double relative_accuracy_;
+    double gamma_;
+    double log_gamma_;
+    long long count_;
+    long long zero_count_;
+    long long non_finite_count_;
+    std::map<int, long long> buckets_;  ///< Bucket index -> number of values; empty buckets are erased.
+
+    /**
+     * Helper function to find the bucket index of a finite value above MIN_POSITIVE
+     */
+    int bucketOf(const double& value) const;
+
+    /**
+     * Helper function to find the value reported for every value in a bucket
+     */
+    double estimate(const int& bucket) const;
+};
+
+#endif // QUANTILE_SKETCH_HPP
@@ -0,0 +1,96 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#include "RunningStats.hpp"
+#include <cmath>
+
+RunningStats::RunningStats() : count_(0), mean_(0), m2_(0), non_finite_count_(0) {}
+
+/**
+ * @brief Welford's update for one new value. NaN and infinities are only
+ * counted by getNonFiniteCount().
+ *
+ * @param value The value to add.
+ */
+void RunningStats::add(const double& value) {
+    if (!std::isfinite(value)) {
+        non_finite_count_++;
+        return;
+    }
+    count_++;
+    double delta = value - mean_;
+    mean_ += delta / count_;
+    m2_ += delta * (value - mean_);
+}
+
+/**
+ * @brief Welford's update run backwards.
+ *
+ * The variance is clamped at zero, since rounding can leave a tiny negative
+ * remainder after many removals.
+ *
+ * @param value The value to remove.
+ */
+void RunningStats::remove(const double& value) {
+    if (!std::isfinite(value)) {
+        if (non_finite_count_ > 0) non_finite_count_--;
+        return;
+    }
+    if (count_ <= 1) {
+        count_ = 0;
+        mean_ = 0;
+        m2_ = 0;
+        return;
+    }
+    double mean_before = mean_;
+    count_--;
+    mean_ -= (value - mean_) / count_;
+    m2_ -= (value - mean_before) * (value - mean_);
+    if (m2_ < 0) {
+        m2_ = 0;
+    }
+}
+
+/**
+ * @brief Combines two sets of statistics as if every value had been added to one.
+ *
+ * @param other The statistics to add.
+ */
+void RunningStats::merge(const RunningStats& other) {
+    non_finite_count_ += other.non_finite_count_;
+    if (other.count_ == 0) {
+        return;
+    }
+    if (count_ == 0) {
+        count_ = other.count_;
+        mean_ = other.mean_;
+        m2_ = other.m2_;
+        return;
+    }
+    int total = count_ + other.count_;
+    double delta = other.mean_ - mean_;
+    mean_ += delta * other.count_ / total;
+    m2_ += other.m2_ + delta * delta * (double(count_) * other.count_ / total);
+    count_ = total;
+}
+
+int RunningStats::getCount() const {
+    return count_;
+}
+
+int RunningStats::getNonFiniteCount() const {
+    return non_finite_count_;
+}
+
+double RunningStats::getMean() const {
+    return mean_;
+}
+
+double RunningStats::getVariance() const {
+    return count_ > 1 ? m2_ / count_ : 0;
+}
+
+double RunningStats::getStandardDeviation() const {
+    return std::sqrt(getVariance());
+}
@@ -0,0 +1,73 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#ifndef RUNNING_STATS_HPP
+#define RUNNING_STATS_HPP
+
+/**
+ * @class RunningStats
+ * @brief Count, mean and variance of a multiset of values, updated one value at a time.
+ *
+ * Uses Welford's update, which stays accurate where the textbook
+ * sum-of-squares formula cancels catastrophically. Values can also be
+ * removed (by running the update backwards) and two sets of statistics
+ * can be merged (Chan et al.'s pairwise formula), so shards can keep
+ * their own and combine them on demand. NaN and infinities would poison
+ * the mean for good, so they are left out and only counted by
+ * getNonFiniteCount().
+ */
+class RunningStats {
+public:
+    /**
+     * Default constructor.
+     * @post getCount() == 0.
+     */
+    RunningStats();
+
+    /**
+     * Adds one value.
+     */
+    void add(const double& value);
+
+    /**
+     * Removes one value that was previously added.
+     * @pre value was added and not yet removed.
+     */
+    void remove(const double& value);
+
+    /**
+     * Adds every value counted by other.
+     */
+    void merge(const RunningStats& other);
+
+    int getCount() const;
+
+    /**
+     * @return The number of NaN and infinite values passed to add() and not removed.
+     */
+    int getNonFiniteCount() const;
+
+    /**
+     * @return The mean, or 0 if there are no values.
+     */
+    double getMean() const;
+
+    /**
+     * @return The population variance, or 0 if there are fewer than two values.
+     */
+    double getVariance() const;
+
+    /**
+     * @return The population standard deviation.
+     */
+    double getStandardDeviation() const;
+
+private:
+    int count_;
+    double mean_;
+    double m2_;  ///< Sum of squared deviations from the mean.
+    int non_finite_count_;
+};
+
+#endif // RUNNING_STATS_HPP
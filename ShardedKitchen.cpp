@@ -0,0 +1,200 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#include "ShardedKitchen.hpp"
+#include <functional>
+
+/**
+ * @brief Creates the shards and their locks.
+ *
+ * @param shard_count The number of shards; values below 1 are treated as 1.
+ * @param partitioning How dishes are assigned to shards.
+ */
+ShardedKitchen::ShardedKitchen(const int& shard_count, const Partitioning& partitioning)
+    : partitioning_(partitioning) {
+    int count = shard_count > 0 ? shard_count : 1;
+    for (int i = 0; i < count; i++) {
+        shards_.emplace_back(new Kitchen());
+        locks_.emplace_back(new std::mutex());
+    }
+}
+
+/**
+ * @brief Adds a dish to the shard that owns it.
+ *
+ * @param new_dish The dish to add.
+ * @return true if the dish was added.
+ */
+bool ShardedKitchen::newOrder(Dish* new_dish) {
+    if (new_dish == nullptr) {
+        return false;
+    }
+    int shard = shardOf(new_dish);
+    std::lock_guard<std::mutex> lock(*locks_[shard]);
+    return shards_[shard]->newOrder(new_dish);
+}
+
+/**
+ * @brief Serves a dish from the shard that owns it.
+ *
+ * @param dish_to_remove A dish equal to the one to serve.
+ * @return true if a matching dish was found and served; false for nullptr.
+ */
+bool ShardedKitchen::serveDish(const Dish* dish_to_remove) {
+    if (dish_to_remove == nullptr) {
+        return false;
+    }
+    int shard = shardOf(dish_to_remove);
+    std::lock_guard<std::mutex> lock(*locks_[shard]);
+    return shards_[shard]->serveDish(dish_to_remove);
+}
+
+int ShardedKitchen::getShardCount() const {
+    return shards_.size();
+}
+
+/**
+ * @brief Picks the owning shard from the dish's name hash or cuisine type.
+ *
+ * @param dish The dish to route.
+ * @return int The shard number.
+ */
+int ShardedKitchen::shardOf(const Dish* dish) const {
+    if (partitioning_ == BY_CUISINE) {
+        return Kitchen::stringToCuisineType(dish->getCuisineType()) % shards_.size();
+    }
+    return std::hash<std::string>()(dish->getName()) % shards_.size();
+}
+
+/**
+ * @brief Adds up the report figures of every shard.
+ *
+ * Each shard's figures are its running totals, so the dishes are not scanned
+ * while a shard is locked.
+ *
+ * @return Kitchen::ReportSummary The merged figures.
+ */
+Kitchen::ReportSummary ShardedKitchen::reportSummary() const {
+    Kitchen::ReportSummary merged = {};
+    for (size_t i = 0; i < shards_.size(); i++) {
+        Kitchen::ReportSummary shard;
+        {
+            std::lock_guard<std::mutex> lock(*locks_[i]);
+            shard = shards_[i]->reportSummary();
+        }
+        Kitchen::mergeSummary(merged, shard);
+    }
+    return merged;
+}
+
+int ShardedKitchen::getCurrentSize() const {
+    int size = 0;
+    for (size_t i = 0; i < shards_.size(); i++) {
+        std::lock_guard<std::mutex> lock(*locks_[i]);
+        size += shards_[i]->getCurrentSize();
+    }
+    return size;
+}
+
+int ShardedKitchen::getPrepTimeSum() const {
+    int sum = 0;
+    for (size_t i = 0; i < shards_.size(); i++) {
+        std::lock_guard<std::mutex> lock(*locks_[i]);
+        sum += shards_[i]->getPrepTimeSum();
+    }
+    return sum;
+}
+
+/**
+ * @return int The average preparation time over all shards, rounded to the nearest integer.
+ */
+int ShardedKitchen::calculateAvgPrepTime() const {
+    int size = 0;
+    int sum = 0;
+    for (size_t i = 0; i < shards_.size(); i++) {
+        std::lock_guard<std::mutex> lock(*locks_[i]);
+        size += shards_[i]->getCurrentSize();
+        sum += shards_[i]->getPrepTimeSum();
+    }
+    if (size == 0) {
+        return 0;
+    }
+    return round(double(sum) / size);
+}
+
+int ShardedKitchen::elaborateDishCount() const {
+    int count = 0;
+    for (size_t i = 0; i < shards_.size(); i++) {
+        std::lock_guard<std::mutex> lock(*locks_[i]);
+        count += shards_[i]->elaborateDishCount();
+    }
+    return count;
+}
+
+/**
+ * @return double The percentage of elaborate dishes over all shards, rounded to two decimal places.
+ */
+double ShardedKitchen::calculateElaboratePercentage() const {
+    int size = 0;
+    int count = 0;
+    for (size_t i = 0; i < shards_.size(); i++) {
+        std::lock_guard<std::mutex> lock(*locks_[i]);
+        size += shards_[i]->getCurrentSize();
+        count += shards_[i]->elaborateDishCount();
+    }
+    if (size == 0 || count == 0) {
+        return 0;
+    }
+    return round(double(count) / double(size) * 10000)/100;
+}
+
+/**
+ * @param cuisine_type The cuisine type to count, e.g. "ITALIAN".
+ * @return int The number of matching dishes over all shards. With BY_CUISINE
+ *         partitioning only the owning shard is consulted.
+ */
+int ShardedKitchen::tallyCuisineTypes(const std::string& cuisine_type) const {
+    if (partitioning_ == BY_CUISINE) {
+        int shard = Kitchen::stringToCuisineType(cuisine_type) % shards_.size();
+        std::lock_guard<std::mutex> lock(*locks_[shard]);
+        return shards_[shard]->tallyCuisineTypes(cuisine_type);
+    }
+    int count = 0;
+    for (size_t i = 0; i < shards_.size(); i++) {
+        std::lock_guard<std::mutex> lock(*locks_[i]);
+        count += shards_[i]->tallyCuisineTypes(cuisine_type);
+    }
+    return count;
+}
+
+/**
+ * @brief Prints the merged report in the Kitchen::kitchenReport() format.
+ */
+void ShardedKitchen::kitchenReport() const {
+    Kitchen::printReport(reportSummary());
+}
+
+/**
+ * @return QuantileSketch The price sketch of every shard, merged.
+ */
+QuantileSketch ShardedKitchen::priceSketch() const {
+    QuantileSketch merged;
+    for (size_t i = 0; i < shards_.size(); i++) {
+        std::lock_guard<std::mutex> lock(*locks_[i]);
+        merged.merge(shards_[i]->priceSketch());
+    }
+    return merged;
+}
+
+/**
+ * @return QuantileSketch The preparation time sketch of every shard, merged.
+ */
+QuantileSketch ShardedKitchen::prepTimeSketch() const {
+    QuantileSketch merged;
+    for (size_t i = 0; i < shards_.size(); i++) {
+        std::lock_guard<std::mutex> lock(*locks_[i]);
+        merged.merge(shards_[i]->prepTimeSketch());
+    }
+    return merged;
+}
@@ -0,0 +1,96 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#ifndef SHARDED_KITCHEN_HPP
+#define SHARDED_KITCHEN_HPP
+
+#include "Kitchen.hpp"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @class ShardedKitchen
+ * @brief Spreads dishes over several independent Kitchen shards.
+ *
+ * Each dish is owned by exactly one shard, chosen from its name or its
+ * cuisine type. Both are part of Dish equality, so serveDish() can route a
+ * removal to the shard that holds the matching dish. Every shard has its own
+ * mutex: operations on dishes in different shards never wait for each other.
+ * Aggregate queries lock the shards one at a time and merge their figures, so
+ * they are exact when no mutation runs concurrently.
+ */
+class ShardedKitchen {
+public:
+    /**
+     * @enum Partitioning
+     * @brief How dishes are assigned to shards.
+     */
+    enum Partitioning { BY_NAME, BY_CUISINE };
+
+    /**
+     * @param shard_count The number of shards (at least 1).
+     * @param partitioning How dishes are assigned to shards.
+     */
+    ShardedKitchen(const int& shard_count, const Partitioning& partitioning = BY_NAME);
+
+    /**
+     * Adds a dish to its owning shard. The shard takes ownership of the dish.
+     * @return True if the dish was added.
+     */
+    bool newOrder(Dish* new_dish);
+
+    /**
+     * Serves (removes and frees) a dish equal to dish_to_remove from its owning shard.
+     * @return True if a matching dish was found.
+     */
+    bool serveDish(const Dish* dish_to_remove);
+
+    int getShardCount() const;
+
+    /**
+     * @param dish A dish; only its name or cuisine type is read.
+     * @return The number (0 to getShardCount() - 1) of the shard that owns such a dish.
+     */
+    int shardOf(const Dish* dish) const;
+
+    /**
+     * @return The total number of dishes over all shards.
+     */
+    int getCurrentSize() const;
+
+    int getPrepTimeSum() const;
+    int calculateAvgPrepTime() const;
+    int elaborateDishCount() const;
+    double calculateElaboratePercentage() const;
+    int tallyCuisineTypes(const std::string& cuisine_type) const;
+
+    /**
+     * @return The per-shard report figures added together.
+     */
+    Kitchen::ReportSummary reportSummary() const;
+
+    /**
+     * Prints the merged figures in the Kitchen::kitchenReport() format.
+     */
+    void kitchenReport() const;
+
+    /**
+     * @return The shards' price sketches merged into one.
+     */
+    QuantileSketch priceSketch() const;
+
+    /**
+     * @return The shards' preparation time sketches merged into one.
+     */
+    QuantileSketch prepTimeSketch() const;
+
+private:
+    std::vector<std::unique_ptr<Kitchen>> shards_;
+    std::vector<std::unique_ptr<std::mutex>> locks_;
+    Partitioning partitioning_;
+};
+
+#endif // SHARDED_KITCHEN_HPP
@@ -0,0 +1,221 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#ifndef SMALL_VECTOR_HPP
+#define SMALL_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @class SmallVector
+ * @brief A vector that keeps up to InlineCapacity elements inside the object itself.
+ *
+ * Elements live in an inline buffer until the size exceeds InlineCapacity, at
+ * which point they are moved to a heap block that grows geometrically. Short
+ * lists therefore need no heap allocation at all.
+ */
+template <class ItemType, std::size_t InlineCapacity>
+class SmallVector {
+public:
+    using value_type = ItemType;
+    using size_type = std::size_t;
+    using iterator = ItemType*;
+    using const_iterator = const ItemType*;
+
+    /**
+     * Default constructor.
+     * @post The vector is empty and uses its inline buffer.
+     */
+    SmallVector() : data_(inlineData()), size_(0), capacity_(InlineCapacity) {}
+
+    /**
+     * @param items The initial elements.
+     */
+    SmallVector(std::initializer_list<ItemType> items) : SmallVector() {
+        assign(items.begin(), items.end());
+    }
+
+    /**
+     * @param items A std::vector whose elements are copied.
+     */
+    SmallVector(const std::vector<ItemType>& items) : SmallVector() {
+        assign(items.begin(), items.end());
+    }
+
+    SmallVector(const SmallVector& other) : SmallVector() {
+        assign(other.begin(), other.end());
+    }
+
+    /**
+     * Move constructor. Steals the heap block if the source has spilled,
+     * otherwise moves the inline elements one by one.
+     */
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible<ItemType>::value) : SmallVector() {
+        takeFrom(other);
+    }
+
+    ~SmallVector() {
+        clear();
+        releaseHeap();
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible<ItemType>::value) {
+        if (this != &other) {
+            clear();
+            releaseHeap();
+            takeFrom(other);
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(const std::vector<ItemType>& items) {
+        assign(items.begin(), items.end());
+        return *this;
+    }
+
+    /**
+     * @return A std::vector holding copies of the elements.
+     */
+    operator std::vector<ItemType>() const {
+        return std::vector<ItemType>(begin(), end());
+    }
+
+    /**
+     * Replaces the contents with the range [first, last).
+     */
+    template <class InputIt>
+    void assign(InputIt first, InputIt last) {
+        clear();
+        reserve(static_cast<size_type>(std::distance(first, last)));
+        for (; first != last; ++first) {
+            ::new (static_cast<void*>(data_ + size_)) ItemType(*first);
+            ++size_;
+        }
+    }
+
+    void push_back(const ItemType& item) {
+        if (size_ == capacity_) {
+            ItemType copy(item);  // item may refer into this vector
+            grow(capacity_ * 2);
+            ::new (static_cast<void*>(data_ + size_)) ItemType(std::move(copy));
+        } else {
+            ::new (static_cast<void*>(data_ + size_)) ItemType(item);
+        }
+        ++size_;
+    }
+
+    void push_back(ItemType&& item) {
+        if (size_ == capacity_) {
+            ItemType moved(std::move(item));
+            grow(capacity_ * 2);
+            ::new (static_cast<void*>(data_ + size_)) ItemType(std::move(moved));
+        } else {
+            ::new (static_cast<void*>(data_ + size_)) ItemType(std::move(item));
+        }
+        ++size_;
+    }
+
+    /**
+     * Ensures room for at least new_capacity elements without reallocating.
+     */
+    void reserve(size_type new_capacity) {
+        if (new_capacity > capacity_) {
+            grow(std::max(new_capacity, capacity_ * 2));
+        }
+    }
+
+    /**
+     * Destroys all elements. The current storage is kept.
+     */
+    void clear() {
+        std::destroy(data_, data_ + size_);
+        size_ = 0;
+    }
+
+    size_type size() const { return size_; }
+    size_type capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * @return True if the elements are stored in the inline buffer.
+     */
+    bool isInline() const { return data_ == inlineData(); }
+
+    ItemType& operator[](size_type index) { return data_[index]; }
+    const ItemType& operator[](size_type index) const { return data_[index]; }
+
+    iterator begin() { return data_; }
+    iterator end() { return data_ + size_; }
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+
+private:
+    alignas(ItemType) unsigned char inline_buffer_[sizeof(ItemType) * InlineCapacity];
+    ItemType* data_;
+    size_type size_;
+    size_type capacity_;
+
+    ItemType* inlineData() { return reinterpret_cast<ItemType*>(inline_buffer_); }
+    const ItemType* inlineData() const { return reinterpret_cast<const ItemType*>(inline_buffer_); }
+
+    /**
+     * Moves the elements into a heap block of new_capacity elements.
+     */
+    void grow(size_type new_capacity) {
+        ItemType* block = static_cast<ItemType*>(::operator new(new_capacity * sizeof(ItemType)));
+        std::uninitialized_move(data_, data_ + size_, block);
+        std::destroy(data_, data_ + size_);
+        releaseHeap();
+        data_ = block;
+        capacity_ = new_capacity;
+    }
+
+    /**
+     * Frees the heap block, if any, and points back at the inline buffer.
+     * @pre All elements have been destroyed.
+     */
+    void releaseHeap() {
+        if (!isInline()) {
+            ::operator delete(data_);
+        }
+        data_ = inlineData();
+        capacity_ = InlineCapacity;
+    }
+
+    /**
+     * Takes the contents of other, leaving it empty.
+     * @pre This vector is empty and inline.
+     */
+    void takeFrom(SmallVector& other) {
+        if (other.isInline()) {
+            std::uninitialized_move(other.begin(), other.end(), data_);
+            size_ = other.size_;
+            other.clear();
+        } else {
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inlineData();
+            other.size_ = 0;
+            other.capacity_ = InlineCapacity;
+        }
+    }
+};
+
+#endif // SMALL_VECTOR_HPP
@@ -0,0 +1,134 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#include "WorkStealingPool.hpp"
+#include <algorithm>
+
+namespace {
+    thread_local const WorkStealingPool* current_pool = nullptr;  ///< Pool of the calling worker thread.
+    thread_local std::size_t current_worker = 0;                  ///< Index of the calling worker thread.
+}
+
+/**
+ * @brief Starts the worker threads, one deque each.
+ *
+ * @param workers The number of workers; 0 uses std::thread::hardware_concurrency().
+ */
+WorkStealingPool::WorkStealingPool(const int& workers)
+    : queued_(0), unfinished_(0), next_queue_(0), stopping_(false) {
+    std::size_t count = workers > 0 ? workers : std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t i = 0; i < count; i++) {
+        queues_.push_back(std::make_unique<TaskQueue>());
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        workers_.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        stopping_ = true;
+    }
+    work_available_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Queues a task on the caller's deque, or round-robin from outside the pool.
+ *
+ * The counters are raised before the task becomes visible, so a worker that
+ * takes it straight away never sees them drop below zero.
+ *
+ * @param task The task to run.
+ */
+void WorkStealingPool::submit(std::function<void()> task) {
+    std::size_t target;
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        queued_++;
+        unfinished_++;
+        target = current_pool == this ? current_worker : next_queue_++ % queues_.size();
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+        queues_[target]->tasks.push_back(std::move(task));
+    }
+    work_available_.notify_one();
+}
+
+/**
+ * @brief Waits until no submitted task is left unfinished.
+ */
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(state_mutex_);
+    all_done_.wait(lock, [this] { return unfinished_ == 0; });
+}
+
+int WorkStealingPool::getWorkerCount() const {
+    return static_cast<int>(workers_.size());
+}
+
+/**
+ * @brief Pops the newest task of the worker's own deque, or steals the oldest task of another.
+ *
+ * @param worker The index of the worker looking for work.
+ * @param task Receives the task.
+ * @return bool True if a task was taken.
+ */
+bool WorkStealingPool::takeTask(const std::size_t& worker, std::function<void()>& task) {
+    {
+        TaskQueue& own = *queues_[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for (std::size_t i = 1; i < queues_.size(); i++) {
+        TaskQueue& victim = *queues_[(worker + i) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Runs tasks until the pool stops, sleeping while every deque is empty.
+ *
+ * @param worker The index of this worker.
+ */
+void WorkStealingPool::workerLoop(const std::size_t& worker) {
+    current_pool = this;
+    current_worker = worker;
+    std::function<void()> task;
+    while (true) {
+        if (takeTask(worker, task)) {
+            {
+                std::lock_guard<std::mutex> lock(state_mutex_);
+                queued_--;
+            }
+            task();
+            task = nullptr;
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            if (--unfinished_ == 0) {
+                all_done_.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(state_mutex_);
+        work_available_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+        if (stopping_ && queued_ == 0) {
+            return;
+        }
+    }
+}
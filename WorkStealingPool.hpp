@@ -0,0 +1,85 @@
+/**
+* @date [10/30/2024]
+ * @author [Farhana Sultana]
+ */
+#ifndef WORK_STEALING_POOL_HPP
+#define WORK_STEALING_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class WorkStealingPool
+ * @brief A fixed set of worker threads, each with its own task deque.
+ *
+ * A worker takes tasks from the back of its own deque and, when that is
+ * empty, steals from the front of the other workers' deques. Tasks submitted
+ * from inside a task go to the submitting worker's deque, so nested work
+ * stays local until another worker runs dry and steals it.
+ */
+class WorkStealingPool {
+public:
+    /**
+     * Starts the workers.
+     * @param workers The number of worker threads; 0 uses one per hardware thread.
+     */
+    explicit WorkStealingPool(const int& workers = 0);
+
+    /**
+     * Waits for every submitted task, then stops the workers.
+     */
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * Queues a task. From a worker of this pool it goes to that worker's deque,
+     * otherwise the deques are filled round-robin.
+     * @param task The task to run.
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * Blocks until every submitted task, including tasks submitted by tasks, has finished.
+     * Must not be called from a task.
+     */
+    void wait();
+
+    /**
+     * @return The number of worker threads.
+     */
+    int getWorkerCount() const;
+
+private:
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<TaskQueue>> queues_;
+    std::vector<std::thread> workers_;
+    std::mutex state_mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable all_done_;
+    std::size_t queued_;       ///< Tasks sitting in a deque.
+    std::size_t unfinished_;   ///< Tasks submitted and not yet finished.
+    std::size_t next_queue_;   ///< Deque for the next submit() from outside the pool.
+    bool stopping_;
+
+    /**
+     * Helper function to take a task from the worker's own deque or steal one from another
+     * @return True if a task was taken.
+     */
+    bool takeTask(const std::size_t& worker, std::function<void()>& task);
+
+    void workerLoop(const std::size_t& worker);
+};
+
+#endif // WORK_STEALING_POOL_HPP